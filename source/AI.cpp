@@ -40,6 +40,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "StellarObject.h"
 #include "System.h"
 #include "Weapon.h"
+#include "WorkerPool.h"
 #include "Wormhole.h"
 
 #include <algorithm>
@@ -336,6 +337,31 @@ namespace {
 
 	// The minimum speed advantage a ship has to have to consider running away.
 	const double SAFETY_MULTIPLIER = 1.1;
+
+	// Attributes that are looked up every frame.
+	const Dictionary::Key AFTERBURNER_ENERGY("afterburner energy");
+	const Dictionary::Key AFTERBURNER_FUEL("afterburner fuel");
+	const Dictionary::Key AFTERBURNER_HEAT("afterburner heat");
+	const Dictionary::Key AFTERBURNER_THRUST("afterburner thrust");
+	const Dictionary::Key ASTEROID_SCAN_POWER("asteroid scan power");
+	const Dictionary::Key ATMOSPHERE_SCAN("atmosphere scan");
+	const Dictionary::Key CARGO_SCAN_POWER("cargo scan power");
+	const Dictionary::Key CLOAK("cloak");
+	const Dictionary::Key CLOAKING_FUEL("cloaking fuel");
+	const Dictionary::Key ENERGY_CAPACITY("energy capacity");
+	const Dictionary::Key ENERGY_CONSUMPTION("energy consumption");
+	const Dictionary::Key ENERGY_GENERATION("energy generation");
+	const Dictionary::Key FUEL_CAPACITY("fuel capacity");
+	const Dictionary::Key FUEL_CONSUMPTION("fuel consumption");
+	const Dictionary::Key FUEL_GENERATION("fuel generation");
+	const Dictionary::Key HULL_REPAIR_RATE("hull repair rate");
+	const Dictionary::Key JUMP_SPEED("jump speed");
+	const Dictionary::Key OUTFIT_SCAN_POWER("outfit scan power");
+	const Dictionary::Key RAMSCOOP("ramscoop");
+	const Dictionary::Key REVERSE_THRUST("reverse thrust");
+	const Dictionary::Key SCRAM_DRIVE("scram drive");
+	const Dictionary::Key SHIELD_GENERATION("shield generation");
+	const Dictionary::Key SOLAR_COLLECTION("solar collection");
 }
 
 
@@ -415,7 +441,7 @@ void AI::UpdateKeys(PlayerInfo &player, Command &activeCommands)
 	// Only toggle the "cloak" command if one of your ships has a cloaking device.
 	if(activeCommands.Has(Command::CLOAK))
 		for(const auto &it : player.Ships())
-			if(!it->IsParked() && it->Attributes().Get("cloak"))
+			if(!it->IsParked() && it->Attributes().Get(CLOAK))
 			{
 				isCloaking = !isCloaking;
 				Messages::Add(isCloaking ? "Engaging cloaking device." : "Disengaging cloaking device."
@@ -651,7 +677,6 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 			&& autoPilot.Has(Command::BOARD));
 
 		Command command;
-		firingCommands.SetHardpoints(it->Weapons().size());
 		if(it->IsYours())
 		{
 			if(it->HasBays() && thisIsLaunching)
@@ -701,21 +726,16 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 				it->SetTargetShip(target);
 			}
 		}
-		if(isPresent)
-		{
-			AimTurrets(*it, firingCommands, it->IsYours() ? opportunisticEscorts : personality.IsOpportunistic());
-			if(targetAsteroid)
-				AutoFire(*it, firingCommands, *targetAsteroid);
-			else
-				AutoFire(*it, firingCommands);
-		}
+		// Pick what to aim and fire at. Which weapons would hit is calculated for
+		// all the ships at once, once they have all decided how to move.
+		Firing &fire = QueueFiring(*it, isPresent,
+			it->IsYours() ? opportunisticEscorts : personality.IsOpportunistic(), targetAsteroid);
 
 		// If this ship is hyperspacing, or in the act of
 		// launching or landing, it can't do anything else.
 		if(it->IsHyperspacing() || it->Zoom() < 1.)
 		{
 			it->SetCommands(command);
-			it->SetCommands(firingCommands);
 			continue;
 		}
 
@@ -791,7 +811,6 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 			{
 				it->SetTargetShip(shipToAssist);
 				it->SetCommands(command);
-				it->SetCommands(firingCommands);
 				continue;
 			}
 		}
@@ -814,7 +833,6 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 			// Flock between allied, in-system ships.
 			DoSwarming(*it, command, target);
 			it->SetCommands(command);
-			it->SetCommands(firingCommands);
 			continue;
 		}
 
@@ -822,6 +840,8 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 		{
 			if(DoSecretive(*it, command))
 			{
+				// Secretive ships that are leaving do not change what they are firing.
+				fire.isApplied = false;
 				it->SetCommands(command);
 				continue;
 			}
@@ -834,7 +854,6 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 		{
 			DoSurveillance(*it, command, target);
 			it->SetCommands(command);
-			it->SetCommands(firingCommands);
 			continue;
 		}
 
@@ -842,7 +861,6 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 		if(isPresent && personality.Harvests() && DoHarvesting(*it, command))
 		{
 			it->SetCommands(command);
-			it->SetCommands(firingCommands);
 			continue;
 		}
 
@@ -859,9 +877,8 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 					command |= Command::DEPLOY;
 					Deploy(*it, false);
 				}
-				DoMining(*it, command);
+				DoMining(*it, command, fire);
 				it->SetCommands(command);
-				it->SetCommands(firingCommands);
 				continue;
 			}
 			// Fighters and drones should assist their parent's mining operation if they cannot
@@ -873,9 +890,8 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 				{
 					it->SetTargetAsteroid(minable);
 					MoveToAttack(*it, command, *minable);
-					AutoFire(*it, firingCommands, *minable);
+					QueueFiring(fire, minable);
 					it->SetCommands(command);
-					it->SetCommands(firingCommands);
 					continue;
 				}
 			}
@@ -899,17 +915,16 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 				// Find the possible parents for orphaned fighters and drones.
 				auto parentChoices = vector<shared_ptr<Ship>>{};
 				parentChoices.reserve(ships.size() * .1);
-				auto getParentFrom = [&it, &gov, &parentChoices](const list<shared_ptr<Ship>> otherShips) -> shared_ptr<Ship>
+				auto canBeParent = [&it, &gov, &parentChoices](const shared_ptr<Ship> &other) -> bool
 				{
-					for(const auto &other : otherShips)
-						if(other->GetGovernment() == gov && other->GetSystem() == it->GetSystem() && !other->CanBeCarried())
-						{
-							if(!other->IsDisabled() && other->CanCarry(*it.get()))
-								return other;
-							else
-								parentChoices.emplace_back(other);
-						}
-					return shared_ptr<Ship>();
+					if(other->GetGovernment() == gov && other->GetSystem() == it->GetSystem() && !other->CanBeCarried())
+					{
+						if(!other->IsDisabled() && other->CanCarry(*it.get()))
+							return true;
+						else
+							parentChoices.emplace_back(other);
+					}
+					return false;
 				};
 				// Mission ships should only pick amongst ships from the same mission.
 				auto missionIt = it->IsSpecial() && !it->IsYours()
@@ -926,13 +941,23 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 						// Don't reparent to NPC ships that have not been spawned.
 						if(!npc.ShouldSpawn())
 							continue;
-						newParent = getParentFrom(npc.Ships());
+						for(const shared_ptr<Ship> &other : npc.Ships())
+							if(canBeParent(other))
+							{
+								newParent = other;
+								break;
+							}
 						if(newParent)
 							break;
 					}
 				}
 				else
-					newParent = getParentFrom(ships);
+					for(const shared_ptr<Ship> &other : ships)
+						if(canBeParent(other))
+						{
+							newParent = other;
+							break;
+						}
 
 				// If a new parent was found, then this carried ship should always reparent
 				// as a ship of its own government is in-system and has space to carry it.
@@ -970,7 +995,6 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 				MoveTo(*it, command, parent->Position(), parent->Velocity(), 40., .8);
 				command |= Command::BOARD;
 				it->SetCommands(command);
-				it->SetCommands(firingCommands);
 				continue;
 			}
 			// If we get here, it means that the ship has not decided to return
@@ -1019,7 +1043,7 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 			MoveIndependent(*it, command);
 		else if(parent->GetSystem() != it->GetSystem())
 		{
-			if(personality.IsStaying() || !it->Attributes().Get("fuel capacity"))
+			if(personality.IsStaying() || !it->Attributes().Get(FUEL_CAPACITY))
 				MoveIndependent(*it, command);
 			else
 				MoveEscort(*it, command);
@@ -1071,8 +1095,9 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 		DoScatter(*it, command);
 
 		it->SetCommands(command);
-		it->SetCommands(firingCommands);
 	}
+
+	DoFiring();
 }
 
 
@@ -1384,8 +1409,8 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 shared_ptr<Ship> AI::FindNonHostileTarget(const Ship &ship) const
 {
 	shared_ptr<Ship> target;
-	bool cargoScan = ship.Attributes().Get("cargo scan power");
-	bool outfitScan = ship.Attributes().Get("outfit scan power");
+	bool cargoScan = ship.Attributes().Get(CARGO_SCAN_POWER);
+	bool outfitScan = ship.Attributes().Get(OUTFIT_SCAN_POWER);
 	if(cargoScan || outfitScan)
 	{
 		const auto allies = GetShipsList(ship, false);
@@ -1521,8 +1546,11 @@ bool AI::FollowOrders(Ship &ship, Command &command) const
 	{
 		if(DoHarvesting(ship, command))
 		{
+			// Ships do not aim or fire while they are collecting flotsam.
+			FireCommand noFiring;
+			noFiring.SetHardpoints(ship.Weapons().size());
 			ship.SetCommands(command);
-			ship.SetCommands(firingCommands);
+			ship.SetCommands(noFiring);
 		}
 		else
 			return false;
@@ -1609,8 +1637,8 @@ void AI::MoveIndependent(Ship &ship, Command &command) const
 	else if(target)
 	{
 		// An AI ship that is targeting a non-hostile ship should scan it, or move on.
-		bool cargoScan = ship.Attributes().Get("cargo scan power");
-		bool outfitScan = ship.Attributes().Get("outfit scan power");
+		bool cargoScan = ship.Attributes().Get(CARGO_SCAN_POWER);
+		bool outfitScan = ship.Attributes().Get(OUTFIT_SCAN_POWER);
 		if((!cargoScan || Has(gov, target, ShipEvent::SCAN_CARGO))
 				&& (!outfitScan || Has(gov, target, ShipEvent::SCAN_OUTFITS)))
 			target.reset();
@@ -1728,7 +1756,7 @@ void AI::MoveIndependent(Ship &ship, Command &command) const
 	else if(ship.GetTargetStellar())
 	{
 		MoveToPlanet(ship, command);
-		if(!shouldStay && ship.Attributes().Get("fuel capacity") && ship.GetTargetStellar()->HasSprite()
+		if(!shouldStay && ship.Attributes().Get(FUEL_CAPACITY) && ship.GetTargetStellar()->HasSprite()
 				&& ship.GetTargetStellar()->GetPlanet() && ship.GetTargetStellar()->GetPlanet()->CanLand(ship))
 			command |= Command::LAND;
 		else if(ship.Position().Distance(ship.GetTargetStellar()->Position()) < 100.)
@@ -1747,7 +1775,7 @@ void AI::MoveEscort(Ship &ship, Command &command) const
 {
 	const Ship &parent = *ship.GetParent();
 	const System *currentSystem = ship.GetSystem();
-	bool hasFuelCapacity = ship.Attributes().Get("fuel capacity");
+	bool hasFuelCapacity = ship.Attributes().Get(FUEL_CAPACITY);
 	bool needsFuel = ship.NeedsFuel();
 	bool isStaying = ship.GetPersonality().IsStaying() || !hasFuelCapacity;
 	bool parentIsHere = (currentSystem == parent.GetSystem());
@@ -1978,9 +2006,9 @@ bool AI::ShouldDock(const Ship &ship, const Ship &parent, const System *playerSy
 
 	// If a carried ship has fuel capacity but is very low, it should return if
 	// the parent can refuel it.
-	double maxFuel = ship.Attributes().Get("fuel capacity");
+	double maxFuel = ship.Attributes().Get(FUEL_CAPACITY);
 	if(maxFuel && ship.Fuel() < .005 && parent.JumpNavigation().JumpFuel() < parent.Fuel() *
-			parent.Attributes().Get("fuel capacity") - maxFuel)
+			parent.Attributes().Get(FUEL_CAPACITY) - maxFuel)
 		return true;
 
 	// NPC ships should always transfer cargo. Player ships should only
@@ -2117,7 +2145,7 @@ bool AI::Stop(Ship &ship, Command &command, double maxSpeed, const Point directi
 
 	// If you have a reverse thruster, figure out whether using it is faster
 	// than turning around and using your main thruster.
-	if(ship.Attributes().Get("reverse thrust"))
+	if(ship.Attributes().Get(REVERSE_THRUST))
 	{
 		// Figure out your stopping time using your main engine:
 		double degreesToTurn = TO_DEG * acos(min(1., max(-1., -velocity.Unit().Dot(angle.Unit()))));
@@ -2125,7 +2153,7 @@ bool AI::Stop(Ship &ship, Command &command, double maxSpeed, const Point directi
 		forwardTime += stopTime;
 
 		// Figure out your reverse thruster stopping time:
-		double reverseAcceleration = ship.Attributes().Get("reverse thrust") / ship.InertialMass();
+		double reverseAcceleration = ship.Attributes().Get(REVERSE_THRUST) / ship.InertialMass();
 		double reverseTime = (180. - degreesToTurn) / ship.TurnRate();
 		reverseTime += speed / reverseAcceleration;
 
@@ -2164,7 +2192,7 @@ bool AI::Stop(Ship &ship, Command &command, double maxSpeed, const Point directi
 void AI::PrepareForHyperspace(Ship &ship, Command &command)
 {
 	bool hasHyperdrive = ship.JumpNavigation().HasHyperdrive();
-	double scramThreshold = ship.Attributes().Get("scram drive");
+	double scramThreshold = ship.Attributes().Get(SCRAM_DRIVE);
 	bool hasJumpDrive = ship.JumpNavigation().HasJumpDrive();
 	if(!hasHyperdrive && !hasJumpDrive)
 		return;
@@ -2214,9 +2242,9 @@ void AI::PrepareForHyperspace(Ship &ship, Command &command)
 	}
 	// If we're a jump drive, just stop.
 	else if(isJump)
-		Stop(ship, command, ship.Attributes().Get("jump speed"));
+		Stop(ship, command, ship.Attributes().Get(JUMP_SPEED));
 	// Else stop in the fastest way to end facing in the right direction
-	else if(Stop(ship, command, ship.Attributes().Get("jump speed"), direction))
+	else if(Stop(ship, command, ship.Attributes().Get(JUMP_SPEED), direction))
 		command.SetTurn(TurnToward(ship, direction));
 }
 
@@ -2328,11 +2356,11 @@ void AI::KeepStation(Ship &ship, Command &command, const Body &target)
 
 	// Determine whether to apply thrust.
 	Point drag = ship.Velocity() * ship.Drag() / mass;
-	if(ship.Attributes().Get("reverse thrust"))
+	if(ship.Attributes().Get(REVERSE_THRUST))
 	{
 		// Don't take drag into account when reverse thrusting, because this
 		// estimate of how it will be applied can be quite inaccurate.
-		Point a = (unit * (-ship.Attributes().Get("reverse thrust") / mass)).Unit();
+		Point a = (unit * (-ship.Attributes().Get(REVERSE_THRUST) / mass)).Unit();
 		double direction = positionWeight * positionDelta.Dot(a) / POSITION_DEADBAND
 			+ velocityWeight * velocityDelta.Dot(a) / VELOCITY_DEADBAND;
 		if(direction > THRUST_DEADBAND)
@@ -2456,7 +2484,7 @@ void AI::MoveToAttack(Ship &ship, Command &command, const Body &target)
 	const auto facing = ship.Facing().Unit().Dot(direction.Unit());
 	// If the ship has reverse thrusters and the target is behind it, we can
 	// use them to reach the target more quickly.
-	if(facing < -.75 && ship.Attributes().Get("reverse thrust"))
+	if(facing < -.75 && ship.Attributes().Get(REVERSE_THRUST))
 		command |= Command::BACK;
 	// This isn't perfect, but it works well enough.
 	else if((facing >= 0. && direction.Length() > diameter)
@@ -2505,18 +2533,18 @@ void AI::PickUp(Ship &ship, Command &command, const Body &target)
 // energy strain, or undue thermal loads if almost overheated.
 bool AI::ShouldUseAfterburner(Ship &ship)
 {
-	if(!ship.Attributes().Get("afterburner thrust"))
+	if(!ship.Attributes().Get(AFTERBURNER_THRUST))
 		return false;
 
-	double fuel = ship.Fuel() * ship.Attributes().Get("fuel capacity");
-	double neededFuel = ship.Attributes().Get("afterburner fuel");
-	double energy = ship.Energy() * ship.Attributes().Get("energy capacity");
-	double neededEnergy = ship.Attributes().Get("afterburner energy");
+	double fuel = ship.Fuel() * ship.Attributes().Get(FUEL_CAPACITY);
+	double neededFuel = ship.Attributes().Get(AFTERBURNER_FUEL);
+	double energy = ship.Energy() * ship.Attributes().Get(ENERGY_CAPACITY);
+	double neededEnergy = ship.Attributes().Get(AFTERBURNER_ENERGY);
 	if(energy == 0.)
-		energy = ship.Attributes().Get("energy generation")
-				+ 0.2 * ship.Attributes().Get("solar collection")
-				- ship.Attributes().Get("energy consumption");
-	double outputHeat = ship.Attributes().Get("afterburner heat") / (100 * ship.Mass());
+		energy = ship.Attributes().Get(ENERGY_GENERATION)
+				+ 0.2 * ship.Attributes().Get(SOLAR_COLLECTION)
+				- ship.Attributes().Get(ENERGY_CONSUMPTION);
+	double outputHeat = ship.Attributes().Get(AFTERBURNER_HEAT) / (100 * ship.Mass());
 	if((!neededFuel || fuel - neededFuel > ship.JumpNavigation().JumpFuel())
 			&& (!neededEnergy || neededEnergy / energy < 0.25)
 			&& (!outputHeat || ship.Heat() + outputHeat < .9))
@@ -2641,7 +2669,7 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 	{
 		// Approach the planet and "land" on it (i.e. scan it).
 		MoveToPlanet(ship, command);
-		double atmosphereScan = ship.Attributes().Get("atmosphere scan");
+		double atmosphereScan = ship.Attributes().Get(ATMOSPHERE_SCAN);
 		double distance = ship.Position().Distance(ship.GetTargetStellar()->Position());
 		if(distance < atmosphereScan && !Random::Int(100))
 			ship.SetTargetStellar(nullptr);
@@ -2651,8 +2679,8 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 	else if(target && target->IsTargetable())
 	{
 		// Approach and scan the targeted, friendly ship's cargo or outfits.
-		bool cargoScan = ship.Attributes().Get("cargo scan power");
-		bool outfitScan = ship.Attributes().Get("outfit scan power");
+		bool cargoScan = ship.Attributes().Get(CARGO_SCAN_POWER);
+		bool outfitScan = ship.Attributes().Get(OUTFIT_SCAN_POWER);
 		// If the pointer to the target ship exists, it is targetable and in-system.
 		bool mustScanCargo = cargoScan && !Has(ship, target, ShipEvent::SCAN_CARGO);
 		bool mustScanOutfits = outfitScan && !Has(ship, target, ShipEvent::SCAN_OUTFITS);
@@ -2674,8 +2702,8 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 
 		// Consider scanning any non-hostile ship in this system that you haven't yet personally scanned.
 		vector<Ship *> targetShips;
-		bool cargoScan = ship.Attributes().Get("cargo scan power");
-		bool outfitScan = ship.Attributes().Get("outfit scan power");
+		bool cargoScan = ship.Attributes().Get(CARGO_SCAN_POWER);
+		bool outfitScan = ship.Attributes().Get(OUTFIT_SCAN_POWER);
 		if(cargoScan || outfitScan)
 			for(const auto &grit : governmentRosters)
 			{
@@ -2695,7 +2723,7 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 
 		// Consider scanning any planetary object in the system, if able.
 		vector<const StellarObject *> targetPlanets;
-		double atmosphereScan = ship.Attributes().Get("atmosphere scan");
+		double atmosphereScan = ship.Attributes().Get(ATMOSPHERE_SCAN);
 		if(atmosphereScan)
 			for(const StellarObject &object : system->Objects())
 				if(object.HasSprite() && !object.IsStar() && !object.IsStation())
@@ -2736,7 +2764,7 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 
 
 
-void AI::DoMining(Ship &ship, Command &command)
+void AI::DoMining(Ship &ship, Command &command, Firing &fire)
 {
 	// This function is only called for ships that are in the player's system.
 	// Update the radius that the ship is searching for asteroids at.
@@ -2775,7 +2803,7 @@ void AI::DoMining(Ship &ship, Command &command)
 		else
 		{
 			MoveToAttack(ship, command, *target);
-			AutoFire(ship, firingCommands, *target);
+			QueueFiring(fire, target);
 			return;
 		}
 	}
@@ -2854,16 +2882,16 @@ bool AI::DoHarvesting(Ship &ship, Command &command) const
 // Check if this ship should cloak. Returns true if this ship decided to run away while cloaking.
 bool AI::DoCloak(Ship &ship, Command &command)
 {
-	if(ship.Attributes().Get("cloak"))
+	if(ship.Attributes().Get(CLOAK))
 	{
 		// Never cloak if it will cause you to be stranded.
 		const Outfit &attributes = ship.Attributes();
-		double fuelCost = attributes.Get("cloaking fuel") + attributes.Get("fuel consumption")
-			- attributes.Get("fuel generation");
-		if(attributes.Get("cloaking fuel") && !attributes.Get("ramscoop"))
+		double fuelCost = attributes.Get(CLOAKING_FUEL) + attributes.Get(FUEL_CONSUMPTION)
+			- attributes.Get(FUEL_GENERATION);
+		if(attributes.Get(CLOAKING_FUEL) && !attributes.Get(RAMSCOOP))
 		{
-			double fuel = ship.Fuel() * attributes.Get("fuel capacity");
-			int steps = ceil((1. - ship.Cloaking()) / attributes.Get("cloak"));
+			double fuel = ship.Fuel() * attributes.Get(FUEL_CAPACITY);
+			int steps = ceil((1. - ship.Cloaking()) / attributes.Get(CLOAK));
 			// Only cloak if you will be able to fully cloak and also maintain it
 			// for as long as it will take you to reach full cloak.
 			fuel -= fuelCost * (1 + 2 * steps);
@@ -2917,7 +2945,7 @@ bool AI::DoCloak(Ship &ship, Command &command)
 		bool cloakFreely = (fuelCost <= 0.) && !ship.GetShipToAssist();
 		// If this ship is injured / repairing, it should cloak while under threat.
 		bool cloakToRepair = (ship.Health() < RETREAT_HEALTH + hysteresis)
-				&& (attributes.Get("shield generation") || attributes.Get("hull repair rate"));
+				&& (attributes.Get(SHIELD_GENERATION) || attributes.Get(HULL_REPAIR_RATE));
 		if(cloakToRepair && (cloakFreely || range < 2000. * (1. + hysteresis)))
 		{
 			command |= Command::CLOAK;
@@ -2982,22 +3010,22 @@ void AI::DoScatter(Ship &ship, Command &command)
 
 bool AI::DoSecretive(Ship &ship, Command &command)
 {
-	shared_ptr<Ship> scanningShip;
+	const Ship *scanningShip = nullptr;
 	// Figure out if any ship is currently scanning us. If that is the case, move away from it.
 	for(auto &otherShip : GetShipsList(ship, false))
 		if(!ship.GetGovernment()->Trusts(otherShip->GetGovernment()) &&
 				otherShip->Commands().Has(Command::SCAN) &&
 				otherShip->GetTargetShip() == ship.shared_from_this() &&
 				!otherShip->IsDisabled() && !otherShip->IsDestroyed())
-			scanningShip = make_shared<Ship>(*otherShip);
+			scanningShip = otherShip;
 
 	if(scanningShip)
 	{
 		Point scanningPos = scanningShip->Position();
 		Point pos = ship.Position();
 
-		double cargoDistance = scanningShip->Attributes().Get("cargo scan power");
-		double outfitDistance = scanningShip->Attributes().Get("outfit scan power");
+		double cargoDistance = scanningShip->Attributes().Get(CARGO_SCAN_POWER);
+		double outfitDistance = scanningShip->Attributes().Get(OUTFIT_SCAN_POWER);
 
 		double maxScanRange = max(cargoDistance, outfitDistance);
 		double distance = scanningPos.DistanceSquared(pos) * .0001;
@@ -3054,10 +3082,10 @@ Point AI::StoppingPoint(const Ship &ship, const Point &targetVelocity, bool &sho
 	// The average term's value will be v / 2. So:
 	stopDistance += .5 * v * v / acceleration;
 
-	if(ship.Attributes().Get("reverse thrust"))
+	if(ship.Attributes().Get(REVERSE_THRUST))
 	{
 		// Figure out your reverse thruster stopping distance:
-		double reverseAcceleration = ship.Attributes().Get("reverse thrust") / ship.InertialMass();
+		double reverseAcceleration = ship.Attributes().Get(REVERSE_THRUST) / ship.InertialMass();
 		double reverseDistance = v * (180. - degreesToTurn) / turnRate;
 		reverseDistance += .5 * v * v / reverseAcceleration;
 
@@ -3123,8 +3151,20 @@ Point AI::TargetAim(const Ship &ship, const Body &target)
 // Aim the given ship's turrets.
 void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic) const
 {
-	// First, get the set of potential hostile ships.
 	auto targets = vector<const Body *>();
+	if(FindTurretTargets(ship, command, opportunistic, targets))
+		AimTurrets(ship, command, targets);
+}
+
+
+
+// Find the bodies that the given ship's turrets should aim at. If there are
+// none, the turrets are pointed forward or swept at random right away.
+bool AI::FindTurretTargets(const Ship &ship, FireCommand &command, bool opportunistic,
+	vector<const Body *> &targets) const
+{
+	// First, get the set of potential hostile ships.
+	targets.clear();
 	const Ship *currentTarget = ship.GetTargetShip().get();
 	if(opportunistic || !currentTarget || !currentTarget->IsTargetable())
 	{
@@ -3135,7 +3175,7 @@ void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic)
 				maxRange = max(maxRange, weapon.GetOutfit()->Range());
 		// If this ship has no turrets, bail out.
 		if(!maxRange)
-			return;
+			return false;
 		// Extend the weapon range slightly to account for velocity differences.
 		maxRange *= 1.5;
 
@@ -3171,7 +3211,7 @@ void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic)
 				double offset = (hardpoint.HarmonizedAngle() - hardpoint.GetAngle()).Degrees();
 				command.SetAim(index, offset / hardpoint.GetOutfit()->TurretTurn());
 			}
-		return;
+		return false;
 	}
 	if(targets.empty())
 	{
@@ -3191,8 +3231,15 @@ void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic)
 				double acceleration = Random::Real() - Random::Real() + bias;
 				command.SetAim(index, previous + .1 * acceleration);
 			}
-		return;
+		return false;
 	}
+	return true;
+}
+
+
+
+void AI::AimTurrets(const Ship &ship, FireCommand &command, const vector<const Body *> &targets)
+{
 	// Each hardpoint should aim at the target that it is "closest" to hitting.
 	for(const Hardpoint &hardpoint : ship.Weapons())
 		if(hardpoint.CanAim())
@@ -3273,8 +3320,25 @@ void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic)
 // Fire whichever of the given ship's weapons can hit a hostile target.
 void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool isFlagship) const
 {
+	FireTargets targets;
+	FindFireTargets(ship, targets, secondary, isFlagship);
+	AutoFire(ship, command, targets);
+}
+
+
+
+// Find the ships that the given ship's weapons may automatically fire at.
+void AI::FindFireTargets(const Ship &ship, FireTargets &targets, bool secondary, bool isFlagship) const
+{
+	targets.secondary = secondary;
+	targets.isFlagship = isFlagship;
+	targets.currentTarget = nullptr;
+	targets.spareTarget = false;
+	targets.enemies.clear();
+
 	const Personality &person = ship.GetPersonality();
-	if(person.IsPacifist() || ship.CannotAct())
+	targets.canFire = !(person.IsPacifist() || ship.CannotAct());
+	if(!targets.canFire)
 		return;
 
 	bool beFrugal = (ship.IsYours() && !escortsUseAmmo);
@@ -3291,6 +3355,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 				beFrugal = false;
 		}
 	}
+	targets.beFrugal = beFrugal;
 
 	// Special case: your target is not your enemy. Do not fire, because you do
 	// not want to risk damaging that target. Ships will target friendly ships
@@ -3317,9 +3382,16 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 	// Only fire on disabled targets if you don't want to plunder them.
 	bool plunders = (person.Plunders() && ship.Cargo().Free());
 	bool disables = person.Disables();
+	auto spare = [&](const Ship &target) -> bool
+	{
+		// NPCs shoot ships that they just plundered.
+		bool hasBoarded = !ship.IsYours() && Has(ship, target.shared_from_this(), ShipEvent::BOARD);
+		return target.IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride;
+	};
 
 	// Don't use weapons with firing force if you are preparing to jump.
 	bool isWaitingToJump = ship.Commands().Has(Command::JUMP | Command::WAIT);
+	targets.isWaitingToJump = isWaitingToJump;
 
 	// Find the longest range of any of your non-homing weapons. Homing weapons
 	// that don't consume ammo may also fire in non-homing mode.
@@ -3341,7 +3413,33 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 	if(currentTarget && currentTarget->IsTargetable()
 			&& find(enemies.cbegin(), enemies.cend(), currentTarget.get()) == enemies.cend())
 		enemies.push_back(currentTarget.get());
+	for(const Ship *target : enemies)
+	{
+		if(spare(*target))
+			continue;
+		// Merciful ships let fleeing ships go.
+		if(target->IsFleeing() && person.IsMerciful())
+			continue;
+		targets.enemies.push_back(target);
+	}
+
+	if(currentTarget)
+	{
+		targets.currentTarget = currentTarget.get();
+		targets.spareTarget = spare(*currentTarget);
+	}
+}
+
 
+
+void AI::AutoFire(const Ship &ship, FireCommand &command, const FireTargets &targets,
+	vector<const Body *> *checked) const
+{
+	if(!targets.canFire)
+		return;
+
+	const Personality &person = ship.GetPersonality();
+	const Ship *currentTarget = targets.currentTarget;
 	int index = -1;
 	for(const Hardpoint &hardpoint : ship.Weapons())
 	{
@@ -3351,7 +3449,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 			continue;
 
 		// Skip weapons omitted by the "Automatic firing" preference.
-		if(isFlagship)
+		if(targets.isFlagship)
 		{
 			const Preferences::AutoFire autoFireMode = Preferences::GetAutoFire();
 			if(autoFireMode == Preferences::AutoFire::GUNS_ONLY && hardpoint.IsTurret())
@@ -3365,25 +3463,25 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 		if(!currentTarget && weapon->Homing() && weapon->Ammo())
 			continue;
 		// Don't fire secondary weapons if told not to.
-		if(!secondary && weapon->Icon())
+		if(!targets.secondary && weapon->Icon())
 			continue;
 		// Don't expend ammo if trying to be frugal.
-		if(beFrugal && weapon->Ammo())
+		if(targets.beFrugal && weapon->Ammo())
 			continue;
 		// Don't use weapons with firing force if you are preparing to jump.
-		if(isWaitingToJump && weapon->FiringForce())
+		if(targets.isWaitingToJump && weapon->FiringForce())
 			continue;
 
 		// Special case: if the weapon uses fuel, be careful not to spend so much
 		// fuel that you cannot leave the system if necessary.
 		if(weapon->FiringFuel())
 		{
-			double fuel = ship.Fuel() * ship.Attributes().Get("fuel capacity");
+			double fuel = ship.Fuel() * ship.Attributes().Get(FUEL_CAPACITY);
 			fuel -= weapon->FiringFuel();
 			// If the ship is not ever leaving this system, it does not need to
 			// reserve any fuel.
 			bool isStaying = person.IsStaying();
-			if(!secondary || fuel < (isStaying ? 0. : ship.JumpNavigation().JumpFuel()))
+			if(!targets.secondary || fuel < (isStaying ? 0. : ship.JumpNavigation().JumpFuel()))
 				continue;
 		}
 		// Figure out where this weapon will fire from, but add some randomness
@@ -3397,9 +3495,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 		// Homing weapons revert to "dumb firing" if they have no target.
 		if(weapon->Homing() && currentTarget)
 		{
-			// NPCs shoot ships that they just plundered.
-			bool hasBoarded = !ship.IsYours() && Has(ship, currentTarget, ShipEvent::BOARD);
-			if(currentTarget->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride)
+			if(targets.spareTarget)
 				continue;
 			// Don't fire secondary weapons at targets that have started jumping.
 			if(weapon->Icon() && currentTarget->IsEnteringHyperspace())
@@ -3430,16 +3526,8 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 			continue;
 		}
 		// For non-homing weapons:
-		for(const auto &target : enemies)
+		for(const Ship *target : targets.enemies)
 		{
-			// NPCs shoot ships that they just plundered.
-			bool hasBoarded = !ship.IsYours() && Has(ship, target->shared_from_this(), ShipEvent::BOARD);
-			if(target->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride)
-				continue;
-			// Merciful ships let fleeing ships go.
-			if(target->IsFleeing() && person.IsMerciful())
-				continue;
-
 			Point p = target->Position() - start;
 			Point v = target->Velocity();
 			// Only take the ship's velocity into account if this weapon
@@ -3460,7 +3548,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 			// Extrapolate over the lifetime of the projectile.
 			v *= lifetime;
 
-			const Mask &mask = target->GetMask(step);
+			const Mask &mask = GetMask(*target, checked);
 			if(mask.Collide(-p, v, target->Facing()) < 1.)
 			{
 				command.SetFire(index);
@@ -3472,7 +3560,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 
 
 
-void AI::AutoFire(const Ship &ship, FireCommand &command, const Body &target) const
+void AI::AutoFire(const Ship &ship, FireCommand &command, const Body &target, vector<const Body *> *checked) const
 {
 	int index = -1;
 	for(const Hardpoint &hardpoint : ship.Weapons())
@@ -3506,7 +3594,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, const Body &target) co
 		// Extrapolate over the lifetime of the projectile.
 		v *= lifetime;
 
-		const Mask &mask = target.GetMask(step);
+		const Mask &mask = GetMask(target, checked);
 		if(mask.Collide(-p, v, target.Facing()) < 1.)
 			command.SetFire(index);
 	}
@@ -3514,6 +3602,111 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, const Body &target) co
 
 
 
+// Get the given body's mask for this step. If a list of checked bodies is
+// given, the body's animation is not stepped, so that several threads may
+// check it at once. Instead, it is added to the list to be stepped later.
+const Mask &AI::GetMask(const Body &body, vector<const Body *> *checked) const
+{
+	if(!checked)
+		return body.GetMask(step);
+
+	checked->push_back(&body);
+	return body.PeekMask(step);
+}
+
+
+
+// Queue up aiming and firing for the given NPC ship. The firing commands
+// of all the queued ships are calculated at once by DoFiring().
+AI::Firing &AI::QueueFiring(Ship &ship, bool isPresent, bool opportunistic, const shared_ptr<Minable> &asteroid)
+{
+	if(firingCount == firing.size())
+		firing.emplace_back();
+	Firing &fire = firing[firingCount++];
+	fire.ship = &ship;
+	fire.command.SetHardpoints(ship.Weapons().size());
+	fire.isApplied = true;
+	fire.aimTurrets = false;
+	fire.autoFire = false;
+	fire.checked.clear();
+	if(!isPresent)
+		return fire;
+
+	// Finding the targets depends on what this ship has decided so far, and
+	// sweeping turrets that have no targets uses random numbers, so both are
+	// done now, in the same order as the ships make their decisions.
+	fire.aimTurrets = FindTurretTargets(ship, fire.command, opportunistic, fire.turretTargets);
+	if(asteroid)
+		QueueFiring(fire, asteroid);
+	else
+	{
+		FindFireTargets(ship, fire.fireTargets, true, false);
+		// The first time a body's mask is checked, its animation may pick a
+		// random starting frame. In that case, fire right away instead.
+		fire.autoFire = none_of(fire.fireTargets.enemies.begin(), fire.fireTargets.enemies.end(),
+			[](const Ship *enemy) -> bool { return enemy->HasPendingStart(); });
+		if(!fire.autoFire)
+			AutoFire(ship, fire.command, fire.fireTargets);
+	}
+	return fire;
+}
+
+
+
+// Also fire at the given asteroid.
+void AI::QueueFiring(Firing &fire, const shared_ptr<Minable> &minable)
+{
+	if(minable->HasPendingStart())
+		AutoFire(*fire.ship, fire.command, *minable);
+	else if(!fire.asteroid)
+		fire.asteroid = minable;
+	else
+		fire.minable = minable;
+}
+
+
+
+// Calculate and apply the firing commands of every queued ship. Calculating the
+// commands only reads the state of the ships, and each calculation only writes
+// to its own command, so they can be spread across several threads. Masks are
+// only peeked at while doing so, and each ship's targets are stepped afterwards
+// in the same order as if each ship had fired as soon as it decided what to do.
+void AI::DoFiring()
+{
+	WorkerPool::Run(firingCount, [this](size_t i) -> void
+	{
+		Firing &fire = firing[i];
+		const Ship &ship = *fire.ship;
+		if(fire.aimTurrets)
+			AimTurrets(ship, fire.command, fire.turretTargets);
+		if(fire.autoFire)
+			AutoFire(ship, fire.command, fire.fireTargets, &fire.checked);
+		if(fire.asteroid)
+			AutoFire(ship, fire.command, *fire.asteroid, &fire.checked);
+		if(fire.minable)
+			AutoFire(ship, fire.command, *fire.minable, &fire.checked);
+	});
+
+	for(size_t i = 0; i < firingCount; ++i)
+	{
+		Firing &fire = firing[i];
+		for(const Body *body : fire.checked)
+			body->GetMask(step);
+		if(fire.isApplied)
+			fire.ship->SetCommands(fire.command);
+		// Don't keep any ships or asteroids alive until the next step.
+		fire.ship = nullptr;
+		fire.turretTargets.clear();
+		fire.fireTargets.currentTarget = nullptr;
+		fire.fireTargets.enemies.clear();
+		fire.asteroid.reset();
+		fire.minable.reset();
+	}
+	firingCount = 0;
+}
+
+
+
 // Get the amount of time it would take the given weapon to reach the given
 // target, assuming it can be fired in any direction (i.e. turreted). For
 // non-turreted weapons this can be used to calculate the ideal direction to
@@ -3556,7 +3749,7 @@ double AI::RendezvousTime(const Point &p, const Point &v, double vp)
 // on the player's preferences.
 bool AI::TargetMinable(Ship &ship) const
 {
-	double scanRangeMetric = 10000. * ship.Attributes().Get("asteroid scan power");
+	double scanRangeMetric = 10000. * ship.Attributes().Get(ASTEROID_SCAN_POWER);
 	if(!scanRangeMetric)
 		return false;
 	const bool findClosest = Preferences::Has("Target asteroid based on");
@@ -4057,7 +4250,7 @@ void AI::MovePlayer(Ship &ship, const PlayerInfo &player, Command &activeCommand
 			command.SetTurn(activeCommands.Has(Command::RIGHT) - activeCommands.Has(Command::LEFT));
 		if(activeCommands.Has(Command::BACK))
 		{
-			if(!activeCommands.Has(Command::FORWARD) && ship.Attributes().Get("reverse thrust"))
+			if(!activeCommands.Has(Command::FORWARD) && ship.Attributes().Get(REVERSE_THRUST))
 				command |= Command::BACK;
 			else if(!activeCommands.Has(Command::RIGHT | Command::LEFT | Command::AUTOSTEER))
 				command.SetTurn(TurnBackward(ship));
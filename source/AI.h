@@ -31,6 +31,7 @@ class AsteroidField;
 class Body;
 class Flotsam;
 class Government;
+class Mask;
 class Minable;
 class PlayerInfo;
 class Ship;
@@ -50,7 +51,7 @@ class AI {
 public:
 	// Any object that can be a ship's target is in a list of this type:
 template <class Type>
-	using List = std::list<std::shared_ptr<Type>>;
+	using List = std::vector<std::shared_ptr<Type>>;
 	// Constructor, giving the AI access to various object lists.
 	AI(const List<Ship> &ships, const List<Minable> &minables, const List<Flotsam> &flotsam);
 
@@ -80,6 +81,9 @@ template <class Type>
 
 
 private:
+	class FireTargets;
+	class Firing;
+
 	// Check if a ship can pursue its target (i.e. beyond the "fence").
 	bool CanPursue(const Ship &ship, const Ship &target) const;
 	// Disabled or stranded ships coordinate with other ships to get assistance.
@@ -123,7 +127,7 @@ private:
 	void DoAppeasing(const std::shared_ptr<Ship> &ship, double *threshold) const;
 	void DoSwarming(Ship &ship, Command &command, std::shared_ptr<Ship> &target);
 	void DoSurveillance(Ship &ship, Command &command, std::shared_ptr<Ship> &target) const;
-	void DoMining(Ship &ship, Command &command);
+	void DoMining(Ship &ship, Command &command, Firing &fire);
 	bool DoHarvesting(Ship &ship, Command &command) const;
 	bool DoCloak(Ship &ship, Command &command);
 	// Prevent ships from stacking on each other when many are moving in sync.
@@ -139,10 +143,23 @@ private:
 	static Point TargetAim(const Ship &ship, const Body &target);
 	// Aim the given ship's turrets.
 	void AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic = false) const;
+	// Find the bodies that the given ship's turrets should aim at. If there are
+	// none, the turrets are pointed forward or swept at random right away.
+	bool FindTurretTargets(const Ship &ship, FireCommand &command, bool opportunistic,
+		std::vector<const Body *> &targets) const;
+	static void AimTurrets(const Ship &ship, FireCommand &command, const std::vector<const Body *> &targets);
 	// Fire whichever of the given ship's weapons can hit a hostile target.
 	// Return a bitmask giving the weapons to fire.
 	void AutoFire(const Ship &ship, FireCommand &command, bool secondary = true, bool isFlagship = false) const;
-	void AutoFire(const Ship &ship, FireCommand &command, const Body &target) const;
+	void FindFireTargets(const Ship &ship, FireTargets &targets, bool secondary, bool isFlagship) const;
+	// If a list of checked bodies is given, their masks are only peeked at, and
+	// each body is added to the list so that it can be stepped afterwards.
+	void AutoFire(const Ship &ship, FireCommand &command, const FireTargets &targets,
+		std::vector<const Body *> *checked = nullptr) const;
+	void AutoFire(const Ship &ship, FireCommand &command, const Body &target,
+		std::vector<const Body *> *checked = nullptr) const;
+	// Get the given body's mask for this step.
+	const Mask &GetMask(const Body &body, std::vector<const Body *> *checked) const;
 
 	// Calculate how long it will take a projectile to reach a target given the
 	// target's relative position and velocity and the velocity of the
@@ -195,10 +212,56 @@ private:
 	};
 
 
+	// The ships that a ship's weapons may automatically fire at. Which of them
+	// to consider depends on the ship's orders and decisions this step.
+	class FireTargets {
+	public:
+		// Pacifists and ships that cannot act do not fire at all.
+		bool canFire = false;
+		bool secondary = true;
+		bool isFlagship = false;
+		bool beFrugal = false;
+		bool isWaitingToJump = false;
+		// The current target, for homing weapons, and whether it should be
+		// spared because it is disabled.
+		const Ship *currentTarget = nullptr;
+		bool spareTarget = false;
+		// The ships that non-homing weapons may fire at.
+		std::vector<const Ship *> enemies;
+	};
+
+	// An NPC ship finds what to aim and fire at while it decides what to do,
+	// but which of its weapons would hit only depends on where the ships are.
+	// That is checked for all the ships at once, in parallel, with each check
+	// only writing to its own ship's command.
+	class Firing {
+	public:
+		Ship *ship = nullptr;
+		FireCommand command;
+		// Secretive ships that are leaving keep firing whatever they were.
+		bool isApplied = true;
+		bool aimTurrets = false;
+		std::vector<const Body *> turretTargets;
+		bool autoFire = false;
+		FireTargets fireTargets;
+		// Asteroids to fire at: the targeted one, and one that is being mined.
+		std::shared_ptr<Minable> asteroid;
+		std::shared_ptr<Minable> minable;
+		// The bodies whose masks were checked, in the order they were checked.
+		std::vector<const Body *> checked;
+	};
+
+
 private:
 	void IssueOrders(const PlayerInfo &player, const Orders &newOrders, const std::string &description);
 	// Convert order types based on fulfillment status.
 	void UpdateOrders(const Ship &ship);
+	// Queue up aiming and firing for the given NPC ship. The firing commands
+	// of all the queued ships are calculated at once by DoFiring().
+	Firing &QueueFiring(Ship &ship, bool isPresent, bool opportunistic, const std::shared_ptr<Minable> &asteroid);
+	// Also fire at the given asteroid.
+	void QueueFiring(Firing &fire, const std::shared_ptr<Minable> &minable);
+	void DoFiring();
 
 
 private:
@@ -219,6 +282,10 @@ private:
 	// thrashing the heap, since we can reuse the storage for
 	// each ship.
 	FireCommand firingCommands;
+	// Ships waiting for their firing commands to be calculated. Only the first
+	// "firingCount" entries are in use, so that their storage can be reused.
+	std::vector<Firing> firing;
+	size_t firingCount = 0;
 
 	bool isCloaking = false;
 
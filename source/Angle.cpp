@@ -164,6 +164,16 @@ Point Angle::Rotate(const Point &point) const
 
 
 
+// Split the full circle into the given number of equal ranges of angles,
+// starting at zero degrees, and find which one this angle is in. The
+// number of ranges must be a power of two, no more than 65536.
+uint32_t Angle::Bucket(uint32_t buckets) const
+{
+	return (static_cast<uint32_t>(angle) * buckets) / STEPS;
+}
+
+
+
 // Constructor using Angle's internal representation.
 Angle::Angle(int32_t angle)
 	: angle(angle)
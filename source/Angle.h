@@ -57,6 +57,11 @@ public:
 	// Return a point rotated by this angle around (0, 0).
 	Point Rotate(const Point &point) const;
 
+	// Split the full circle into the given number of equal ranges of angles,
+	// starting at zero degrees, and find which one this angle is in. The
+	// number of ranges must be a power of two, no more than 65536.
+	uint32_t Bucket(uint32_t buckets) const;
+
 
 private:
 	explicit Angle(int32_t angle);
@@ -18,6 +18,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "DrawList.h"
 #include "Mask.h"
 #include "Minable.h"
+#include "Pool.h"
 #include "Projectile.h"
 #include "Random.h"
 #include "Screen.h"
@@ -33,13 +34,16 @@ namespace {
 	constexpr double WRAP = 4096.;
 	constexpr unsigned CELL_SIZE = 256u;
 	constexpr unsigned CELL_COUNT = WRAP / CELL_SIZE;
+	// Minable asteroids vary a lot in size, so they are stored in a grid with
+	// more than one cell size. Ordinary asteroids are all small enough for one.
+	constexpr unsigned MINABLE_LEVELS = 3u;
 }
 
 
 
 // Constructor, to set up the collision set parameters.
 AsteroidField::AsteroidField()
-	: asteroidCollisions(CELL_SIZE, CELL_COUNT), minableCollisions(CELL_SIZE, CELL_COUNT)
+	: asteroidCollisions(CELL_SIZE, CELL_COUNT), minableCollisions(CELL_SIZE, CELL_COUNT, MINABLE_LEVELS)
 {
 }
 
@@ -73,7 +77,7 @@ void AsteroidField::Add(const Minable *minable, int count, double energy, const
 	// Place copies of the given minable asteroid throughout the system.
 	for(int i = 0; i < count; ++i)
 	{
-		minables.emplace_back(new Minable(*minable));
+		minables.push_back(Pool<Minable>::Make(*minable));
 		minables.back()->Place(energy, belts.Get());
 	}
 }
@@ -94,17 +98,16 @@ void AsteroidField::Step(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flo
 	// Step through the minables. Since they are destructible, we may need to
 	// remove them from the list.
 	minableCollisions.Clear(step);
-	auto it = minables.begin();
-	while(it != minables.end())
-	{
+	auto out = minables.begin();
+	for(auto it = minables.begin(); it != minables.end(); ++it)
 		if((*it)->Move(visuals, flotsam))
 		{
 			minableCollisions.Add(**it);
-			++it;
+			if(out != it)
+				*out = std::move(*it);
+			++out;
 		}
-		else
-			it = minables.erase(it);
-	}
+	minables.erase(out, minables.end());
 	minableCollisions.Finish();
 }
 
@@ -168,7 +171,7 @@ Body *AsteroidField::Collide(const Projectile &projectile, double *closestHit)
 
 
 // Get the list of minable asteroids.
-const list<shared_ptr<Minable>> &AsteroidField::Minables() const
+const vector<shared_ptr<Minable>> &AsteroidField::Minables() const
 {
 	return minables;
 }
@@ -63,7 +63,7 @@ public:
 	Body *Collide(const Projectile &projectile, double *closestHit);
 
 	// Get the list of minable asteroids.
-	const std::list<std::shared_ptr<Minable>> &Minables() const;
+	const std::vector<std::shared_ptr<Minable>> &Minables() const;
 
 
 private:
@@ -84,7 +84,7 @@ private:
 
 private:
 	std::vector<Asteroid> asteroids;
-	std::list<std::shared_ptr<Minable>> minables;
+	std::vector<std::shared_ptr<Minable>> minables;
 
 	CollisionSet asteroidCollisions;
 	CollisionSet minableCollisions;
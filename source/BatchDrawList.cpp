@@ -25,13 +25,18 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
-	void Push(vector<float> &v, const Point &pos, float s, float t, float frame)
+	// The number of attributes that each vertex has.
+	const size_t VERTEX_SIZE = 7;
+
+	void Push(vector<float> &v, const Point &pos, float s, float t, float frame, float step, float frames)
 	{
 		v.push_back(pos.X());
 		v.push_back(pos.Y());
 		v.push_back(s);
 		v.push_back(t);
 		v.push_back(frame);
+		v.push_back(step);
+		v.push_back(frames);
 	}
 }
 
@@ -86,8 +91,38 @@ void BatchDrawList::Draw() const
 {
 	BatchShader::Bind();
 
+	// The textures and atlas regions are only looked up now, on the main thread,
+	// because that is the thread that loads them. Sprites that have their own
+	// textures are drawn right away, and sprites in an atlas are gathered up so
+	// that everything in each atlas texture is drawn together.
+	for(auto &it : atlasData)
+		it.second.clear();
 	for(const pair<const Sprite * const, vector<float>> &it : data)
-		BatchShader::Add(it.first, isHighDPI, it.second);
+	{
+		const SpriteAtlas::Region &region = it.first->AtlasRegion(isHighDPI);
+		if(!region.texture)
+		{
+			uint32_t texture = it.first->Texture(isHighDPI);
+			if(texture)
+				BatchShader::Add(texture, it.second);
+			continue;
+		}
+
+		// Convert the texture coordinates within the sprite into coordinates
+		// within its region of the atlas.
+		vector<float> &v = atlasData[region.texture];
+		for(size_t i = 0; i < it.second.size(); i += VERTEX_SIZE)
+		{
+			v.insert(v.end(), it.second.begin() + i, it.second.begin() + i + VERTEX_SIZE);
+			float *vertex = &v[v.size() - VERTEX_SIZE];
+			vertex[2] = region.left + vertex[2] * region.width;
+			vertex[3] = region.top + vertex[3] * region.height;
+			vertex[5] = region.step;
+		}
+	}
+	for(const pair<const uint32_t, vector<float>> &it : atlasData)
+		if(!it.second.empty())
+			BatchShader::Add(it.first, it.second);
 
 	BatchShader::Unbind();
 }
@@ -122,10 +157,14 @@ bool BatchDrawList::Add(const Body &body, Point position, float clip)
 	if(Cull(body, position))
 		return false;
 
-	// Get the data vector for this particular sprite.
-	vector<float> &v = data[body.GetSprite()];
+	// Get the data vector for this particular sprite. The texture coordinates
+	// are within the sprite, and are converted into coordinates within its
+	// region of an atlas, if it is in one, once it is drawn.
+	const Sprite *sprite = body.GetSprite();
+	vector<float> &v = data[sprite];
 	// The sprite frame is the same for every vertex.
 	float frame = body.GetFrame(step);
+	float frames = sprite->Frames();
 
 	// Get unit vectors in the direction of the object's width and height.
 	Point unit = body.Unit() * zoom;
@@ -145,12 +184,12 @@ bool BatchDrawList::Add(const Body &body, Point position, float clip)
 
 	// Push two copies of the first and last vertices to mark the break between
 	// the sprites.
-	Push(v, topLeft, 0.f, 1.f, frame);
-	Push(v, topLeft, 0.f, 1.f, frame);
-	Push(v, topRight, 1.f, 1.f, frame);
-	Push(v, bottomLeft, 0.f, 1.f - clip, frame);
-	Push(v, bottomRight, 1.f, 1.f - clip, frame);
-	Push(v, bottomRight, 1.f, 1.f - clip, frame);
+	Push(v, topLeft, 0.f, 1.f, frame, 0.f, frames);
+	Push(v, topLeft, 0.f, 1.f, frame, 0.f, frames);
+	Push(v, topRight, 1.f, 1.f, frame, 0.f, frames);
+	Push(v, bottomLeft, 0.f, 1.f - clip, frame, 0.f, frames);
+	Push(v, bottomRight, 1.f, 1.f - clip, frame, 0.f, frames);
+	Push(v, bottomRight, 1.f, 1.f - clip, frame, 0.f, frames);
 
 	return true;
 }
@@ -18,6 +18,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Point.h"
 
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -28,6 +29,7 @@ class Sprite;
 
 // This class collects a set of OpenGL draw commands to issue and groups them by
 // sprite, so all instances of each sprite can be drawn with a single command.
+// Small sprites share atlas textures, so many of them can be drawn together.
 class BatchDrawList {
 public:
 	// Clear the list, also setting the global time step for animation.
@@ -58,9 +60,16 @@ private:
 
 	// Each sprite consists of six vertices (four vertices to form a quad and
 	// two dummy vertices to mark the break in between them). Each of those
-	// vertices has five attributes: (x, y) position in pixels, (s, t) texture
-	// coordinates, and the index of the sprite frame.
+	// vertices has seven attributes: (x, y) position in pixels, (s, t) texture
+	// coordinates, the index of the sprite frame, the distance between frames
+	// in an atlas (or 0 if each frame is a layer of the texture), and the
+	// number of frames. The texture coordinates are within the sprite, and the
+	// distance between frames is 0, until the sprite's texture is looked up.
 	std::map<const Sprite *, std::vector<float>> data;
+	// When the list is drawn, the vertices of sprites that are in an atlas are
+	// gathered up here, for each atlas texture. This is only used while drawing,
+	// and is kept so that its memory can be reused.
+	mutable std::map<uint32_t, std::vector<float>> atlasData;
 };
 
 
@@ -17,7 +17,6 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Screen.h"
 #include "Shader.h"
-#include "Sprite.h"
 
 using namespace std;
 
@@ -25,10 +24,10 @@ namespace {
 	Shader shader;
 	// Uniforms:
 	GLint scaleI;
-	GLint frameCountI;
 	// Vertex data:
 	GLint vertI;
 	GLint texCoordI;
+	GLint frameDataI;
 
 	GLuint vao;
 	GLuint vbo;
@@ -44,12 +43,15 @@ void BatchShader::Init()
 		"uniform vec2 scale;\n"
 		"in vec2 vert;\n"
 		"in vec3 texCoord;\n"
+		"in vec2 frameData;\n"
 
 		"out vec3 fragTexCoord;\n"
+		"out vec2 fragFrameData;\n"
 
 		"void main() {\n"
 		"  gl_Position = vec4(vert * scale, 0, 1);\n"
 		"  fragTexCoord = texCoord;\n"
+		"  fragFrameData = frameData;\n"
 		"}\n";
 
 	static const char *fragmentCode =
@@ -59,28 +61,44 @@ void BatchShader::Init()
 		"precision mediump sampler2DArray;\n"
 #endif
 		"uniform sampler2DArray tex;\n"
-		"uniform float frameCount;\n"
 
+		// Texture coordinates within an atlas need more precision than mediump
+		// has, to pick out single pixels of a 2048 pixel wide texture.
+#ifdef ES_GLES
+		"in highp vec3 fragTexCoord;\n"
+		"in highp vec2 fragFrameData;\n"
+#else
 		"in vec3 fragTexCoord;\n"
+		"in vec2 fragFrameData;\n"
+#endif
 
 		"out vec4 finalColor;\n"
 
 		"void main() {\n"
 		"  float first = floor(fragTexCoord.z);\n"
-		"  float second = mod(ceil(fragTexCoord.z), frameCount);\n"
+		"  float second = mod(ceil(fragTexCoord.z), fragFrameData.y);\n"
 		"  float fade = fragTexCoord.z - first;\n"
+		// Each frame is either a layer of the texture, or (in an atlas) placed
+		// to the right of the previous frame.
+#ifdef ES_GLES
+		"  highp vec3 frameOffset = (fragFrameData.x > 0.) ? vec3(fragFrameData.x, 0, 0) : vec3(0, 0, 1);\n"
+		"  highp vec3 base = vec3(fragTexCoord.xy, 0);\n"
+#else
+		"  vec3 frameOffset = (fragFrameData.x > 0.) ? vec3(fragFrameData.x, 0, 0) : vec3(0, 0, 1);\n"
+		"  vec3 base = vec3(fragTexCoord.xy, 0);\n"
+#endif
 		"  finalColor = mix(\n"
-		"    texture(tex, vec3(fragTexCoord.xy, first)),\n"
-		"    texture(tex, vec3(fragTexCoord.xy, second)), fade);\n"
+		"    texture(tex, base + first * frameOffset),\n"
+		"    texture(tex, base + second * frameOffset), fade);\n"
 		"}\n";
 
 	// Compile the shaders.
 	shader = Shader(vertexCode, fragmentCode);
 	// Get the indices of the uniforms and attributes.
 	scaleI = shader.Uniform("scale");
-	frameCountI = shader.Uniform("frameCount");
 	vertI = shader.Attrib("vert");
 	texCoordI = shader.Attrib("texCoord");
+	frameDataI = shader.Attrib("frameData");
 
 	// Make sure we're using texture 0.
 	glUseProgram(shader.Object());
@@ -94,14 +112,18 @@ void BatchShader::Init()
 	glGenBuffers(1, &vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
-	// In this VAO, enable the two vertex arrays and specify their byte offsets.
-	constexpr auto stride = 5 * sizeof(float);
+	// In this VAO, enable the three vertex arrays and specify their byte offsets.
+	constexpr auto stride = 7 * sizeof(float);
 	glEnableVertexAttribArray(vertI);
 	glVertexAttribPointer(vertI, 2, GL_FLOAT, GL_FALSE, stride, nullptr);
 	// The 3 texture fields (s, t, frame) come after the x,y pixel fields.
 	auto textureOffset = reinterpret_cast<const GLvoid *>(2 * sizeof(float));
 	glEnableVertexAttribArray(texCoordI);
 	glVertexAttribPointer(texCoordI, 3, GL_FLOAT, GL_FALSE, stride, textureOffset);
+	// The 2 frame fields (distance between frames, frame count) come last.
+	auto frameOffset = reinterpret_cast<const GLvoid *>(5 * sizeof(float));
+	glEnableVertexAttribArray(frameDataI);
+	glVertexAttribPointer(frameDataI, 2, GL_FLOAT, GL_FALSE, stride, frameOffset);
 
 	// Unbind the buffer and the VAO, but leave the vertex attrib arrays enabled
 	// in the VAO so they will be used when it is bound.
@@ -125,22 +147,21 @@ void BatchShader::Bind()
 
 
 
-void BatchShader::Add(const Sprite *sprite, bool isHighDPI, const vector<float> &data)
+void BatchShader::Add(uint32_t texture, const vector<float> &data)
 {
 	// Do nothing if there are no sprites to draw.
 	if(data.empty())
 		return;
 
-	// First, bind the proper texture.
-	glBindTexture(GL_TEXTURE_2D_ARRAY, sprite->Texture(isHighDPI));
-	// The shader also needs to know how many frames the texture has.
-	glUniform1f(frameCountI, sprite->Frames());
+	// First, bind the proper texture. The vertex data says where in it each
+	// sprite's frames are.
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
 
 	// Upload the vertex data.
 	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * data.size(), data.data(), GL_STREAM_DRAW);
 
 	// Draw all the vertices.
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, data.size() / 5);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, data.size() / 7);
 }
 
 
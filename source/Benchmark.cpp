@@ -0,0 +1,171 @@
+/* Benchmark.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "Benchmark.h"
+
+#include "Engine.h"
+#include "Files.h"
+#include "FrameTimer.h"
+#include "GameData.h"
+#include "Logger.h"
+#include "MaskManager.h"
+#include "PlayerInfo.h"
+#include "Random.h"
+#include "Ship.h"
+#include "ShipEvent.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// Every run uses the same seed, so that the same saved game always
+	// produces the same sequence of events.
+	const uint64_t SEED = 0;
+
+	const vector<pair<Engine::Phase, string>> PHASES = {
+		{Engine::Phase::AI, "ai step"},
+		{Engine::Phase::MOVE_SHIPS, "move ships"},
+		{Engine::Phase::MOVE_PROJECTILES, "move projectiles"},
+		{Engine::Phase::FILL_COLLISION_SETS, "fill collision sets"},
+		{Engine::Phase::DO_COLLISIONS, "do collisions"},
+		{Engine::Phase::FILL_RADAR, "fill radar"},
+		{Engine::Phase::ADD_SPRITES, "add sprites"}
+	};
+
+	// Mix the given value into a 64-bit FNV-1a hash.
+	void Hash(uint64_t &hash, double value)
+	{
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		for(int i = 0; i < 8; ++i)
+		{
+			hash = (hash ^ ((bits >> (8 * i)) & 0xFF)) * 1099511628211ull;
+		}
+	}
+
+	// Get a checksum of the state of the player's ships, so that two runs of
+	// the same benchmark can be checked for producing exactly the same result.
+	uint64_t Checksum(const PlayerInfo &player)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for(const shared_ptr<Ship> &ship : player.Ships())
+		{
+			Hash(hash, ship->Position().X());
+			Hash(hash, ship->Position().Y());
+			Hash(hash, ship->Velocity().X());
+			Hash(hash, ship->Velocity().Y());
+			Hash(hash, ship->Facing().Degrees());
+			Hash(hash, ship->Shields());
+			Hash(hash, ship->Hull());
+			Hash(hash, ship->Energy());
+			Hash(hash, ship->Heat());
+		}
+		return hash;
+	}
+
+	void PrintRow(const string &name, double seconds, int steps)
+	{
+		cout << left << setw(24) << name << right << fixed << setprecision(3)
+			<< setw(12) << seconds * 1000. << setw(12) << seconds * 1000. / steps << endl;
+	}
+}
+
+
+
+// Load the given saved game, take off, and simulate the given number of
+// steps. The time spent in each phase of the simulation is printed to
+// the console. The game data must already have been loaded.
+int Benchmark::Run(const string &savePath, int steps)
+{
+	if(steps <= 0)
+	{
+		Logger::LogError("The number of benchmark steps must be positive.");
+		return 1;
+	}
+	if(!Files::Exists(savePath))
+	{
+		Logger::LogError("Saved game \"" + savePath + "\" not found.");
+		return 1;
+	}
+
+	// The sprites are needed for their dimensions and collision masks, but are
+	// never uploaded because there is no OpenGL context.
+	GameData::FinishLoadingSprites();
+	GameData::GetMaskManager().ScaleMasks();
+	GameData::GetMaskManager().CacheBounds();
+	GameData::FinishLoading();
+
+	PlayerInfo player;
+	player.Load(savePath);
+	if(!player.IsLoaded() || !player.Flagship())
+	{
+		Logger::LogError("Saved game \"" + savePath + "\" has no flagship to fly.");
+		return 1;
+	}
+	// Saved games are normally landed on a planet.
+	if(player.GetPlanet() && !player.TakeOff(nullptr))
+	{
+		Logger::LogError("Unable to take off from the planet in \"" + savePath + "\".");
+		return 1;
+	}
+
+	// Loading a saved game reseeds the random number generator, so seed it
+	// only once the player is ready to fly.
+	Random::Seed(SEED);
+	Engine engine(player);
+	engine.Place();
+	engine.SetProfiling(true);
+
+	FrameTimer timer;
+	for(int i = 0; i < steps; ++i)
+	{
+		engine.Calculate();
+		engine.Step(false);
+		// Nothing reacts to the ship events during a benchmark.
+		engine.Events().clear();
+	}
+	double total = timer.Time();
+
+	cout << "Simulated " << steps << " steps of \"" << Files::Name(savePath) << "\" with seed " << SEED << "."
+		<< endl << endl;
+	cout << left << setw(24) << "phase" << right << setw(12) << "total (ms)" << setw(12) << "step (ms)" << endl;
+	double profiled = 0.;
+	for(const auto &it : PHASES)
+	{
+		double time = engine.ProfiledTime(it.first);
+		profiled += time;
+		PrintRow(it.second, time, steps);
+	}
+	PrintRow("other", max(0., total - profiled), steps);
+	PrintRow("total", total, steps);
+	cout << endl << "State checksum: " << hex << Checksum(player) << dec << endl;
+	return 0;
+}
+
+
+
+void Benchmark::Help()
+{
+	cerr << "    --benchmark <save>: load the given saved game, take off, and simulate the flight engine"
+			" without a window, printing the time spent in each phase." << endl;
+	cerr << "    --steps <count>: the number of steps to simulate in a benchmark (default 3600)." << endl;
+}
@@ -0,0 +1,38 @@
+/* Benchmark.h
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <string>
+
+
+
+// A class containing methods used to measure the cost of the flight simulation
+// without a window. A saved game is loaded and the engine is stepped a fixed
+// number of times with a fixed random seed, so that the results of two runs
+// can be compared with each other.
+class Benchmark {
+public:
+	// Load the given saved game, take off, and simulate the given number of
+	// steps. The time spent in each phase of the simulation is printed to
+	// the console. The game data must already have been loaded.
+	static int Run(const std::string &savePath, int steps);
+	static void Help();
+};
+
+
+
+#endif
@@ -119,15 +119,30 @@ const Mask &Body::GetMask(int step) const
 	if(step >= 0)
 		SetStep(step);
 
-	static const Mask EMPTY;
-	int current = round(frame);
-	if(!sprite || current < 0)
-		return EMPTY;
+	return FrameMask(frame);
+}
 
-	const vector<Mask> &masks = GameData::GetMaskManager().GetMasks(sprite, Scale());
 
-	// Assume that if a masks array exists, it has the right number of frames.
-	return masks.empty() ? EMPTY : masks[current % masks.size()];
+
+// Get the mask for the given time step without remembering that step, so that
+// several threads may check the same body at once. This is the same mask that
+// GetMask() would return, as long as the starting frame is not still pending.
+const Mask &Body::PeekMask(int step) const
+{
+	step -= pause;
+	if(step == currentStep || step < 0 || !sprite || !sprite->Frames())
+		return FrameMask(frame);
+
+	return FrameMask(sprite->Frames() <= 1.f ? 0.f : FrameAt(step));
+}
+
+
+
+// Check if the next time step that is given will also pick this animation's
+// starting frame, which may be random.
+bool Body::HasPendingStart() const
+{
+	return (randomize || startAtZero) && sprite && sprite->Frames() > 1.f;
 }
 
 
@@ -367,30 +382,60 @@ void Body::SetStep(int step) const
 		frameOffset -= frameRate * step;
 	}
 
+	frame = FrameAt(step);
+}
+
+
+
+// Get the frame index for the given time step, once the starting frame has been
+// picked. The step must already be adjusted for pauses.
+float Body::FrameAt(int step) const
+{
+	float frames = sprite->Frames();
+	float lastFrame = frames - 1.f;
+	float cycle = (rewind ? 2.f * lastFrame : frames) + delay;
+
 	// Figure out what fraction of the way in between frames we are. Avoid any
 	// possible floating-point glitches that might result in a negative frame.
-	frame = max(0.f, frameRate * step + frameOffset);
+	float result = max(0.f, frameRate * step + frameOffset);
 	// If repeating, wrap the frame index by the total cycle time.
 	if(repeat)
-		frame = fmod(frame, cycle);
+		result = fmod(result, cycle);
 
 	if(!rewind)
 	{
 		// If not repeating, frame should never go higher than the index of the
 		// final frame.
 		if(!repeat)
-			frame = min(frame, lastFrame);
-		else if(frame >= frames)
+			result = min(result, lastFrame);
+		else if(result >= frames)
 		{
 			// If we're in the delay portion of the loop, set the frame to 0.
-			frame = 0.f;
+			result = 0.f;
 		}
 	}
-	else if(frame >= lastFrame)
+	else if(result >= lastFrame)
 	{
 		// In rewind mode, once you get to the last frame, count backwards.
 		// Regardless of whether we're repeating, if the frame count gets to
 		// be less than 0, clamp it to 0.
-		frame = max(0.f, lastFrame * 2.f - frame);
+		result = max(0.f, lastFrame * 2.f - result);
 	}
+	return result;
+}
+
+
+
+// Get the collision mask for the given frame index.
+const Mask &Body::FrameMask(float index) const
+{
+	static const Mask EMPTY;
+	int current = round(index);
+	if(!sprite || current < 0)
+		return EMPTY;
+
+	const vector<Mask> &masks = GameData::GetMaskManager().GetMasks(sprite, Scale());
+
+	// Assume that if a masks array exists, it has the right number of frames.
+	return masks.empty() ? EMPTY : masks[current % masks.size()];
 }
@@ -53,6 +53,12 @@ public:
 	// Get the sprite frame and mask for the given time step.
 	float GetFrame(int step = -1) const;
 	const Mask &GetMask(int step = -1) const;
+	// Get the mask for the given time step without remembering that step, so
+	// that several threads may check the same body at once.
+	const Mask &PeekMask(int step) const;
+	// Check if the next time step that is given will also pick this animation's
+	// starting frame, which may be random.
+	bool HasPendingStart() const;
 
 	// Positional attributes.
 	const Point &Position() const;
@@ -107,6 +113,11 @@ private:
 	// Set what animation step we're on. This affects future calls to GetMask()
 	// and GetFrame().
 	void SetStep(int step) const;
+	// Get the frame index for the given time step, once the starting frame has
+	// been picked. The step must already be adjusted for pauses.
+	float FrameAt(int step) const;
+	// Get the collision mask for the given frame index.
+	const Mask &FrameMask(float index) const;
 
 
 private:
@@ -22,6 +22,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Point.h"
 #include "Projectile.h"
 #include "Ship.h"
+#include "WorkerPool.h"
 
 #include <algorithm>
 #include <cstdlib>
@@ -66,19 +67,120 @@ namespace {
 		double closest_dist;
 		Body *closest_body;
 	};
+
+	// Cap the length of a line to prevent integer overflows. Returns true if
+	// the line had to be shortened.
+	bool CapVelocity(const Point &from, Point &to)
+	{
+		const Point pVelocity = (to - from);
+		if(pVelocity.Length() <= MAX_VELOCITY)
+			return false;
+
+		if(!warned)
+		{
+			Logger::LogError("Warning: maximum projectile velocity is " + to_string(MAX_VELOCITY));
+			warned = true;
+		}
+		to = from + pVelocity.Unit() * USED_MAX_VELOCITY;
+		return true;
+	}
+
+	// Call visit(gx, gy) for each grid cell that the given line passes through,
+	// in order, until either it returns true or the final grid cell is reached.
+	template <class Visit>
+	void WalkCells(const Point &from, const Point &to, unsigned shift, Visit visit)
+	{
+		const int x = from.X();
+		const int y = from.Y();
+		const int endX = to.X();
+		const int endY = to.Y();
+
+		// Figure out which grid cell the line starts and ends in.
+		int gx = x >> shift;
+		int gy = y >> shift;
+		const int endGX = endX >> shift;
+		const int endGY = endY >> shift;
+
+		// When stepping from one grid cell to the next, we'll go in this direction.
+		const int stepX = (x <= endX ? 1 : -1);
+		const int stepY = (y <= endY ? 1 : -1);
+		// Calculate the slope of the line, shifted so it is positive in both axes.
+		const uint64_t mx = abs(endX - x);
+		const uint64_t my = abs(endY - y);
+		// Behave as if each grid cell has this width and height. This guarantees
+		// that we only need to work with integer coordinates.
+		const uint64_t cellSize = 1u << shift;
+		const uint64_t scale = max<uint64_t>(mx, 1) * max<uint64_t>(my, 1);
+		const uint64_t fullScale = cellSize * scale;
+
+		// Get the "remainder" distance that we must travel in x and y in order to
+		// reach the next grid cell. These ensure we only check grid cells which the
+		// line will pass through.
+		uint64_t rx = scale * (x & (cellSize - 1));
+		uint64_t ry = scale * (y & (cellSize - 1));
+		if(stepX > 0)
+			rx = fullScale - rx;
+		if(stepY > 0)
+			ry = fullScale - ry;
+
+		while(true)
+		{
+			// Check if we're done or have reached the final grid cell.
+			if(visit(gx, gy) || (gx == endGX && gy == endGY))
+				break;
+			// If not, move to the next one. Check whether rx / mx < ry / my.
+			const int64_t diff = rx * my - ry * mx;
+			if(!diff)
+			{
+				// The line is exactly intersecting a corner.
+				rx = fullScale;
+				ry = fullScale;
+				// Make sure we don't step past the end grid.
+				if(gx == endGX && gy + stepY == endGY)
+					break;
+				if(gy == endGY && gx + stepX == endGX)
+					break;
+				gx += stepX;
+				gy += stepY;
+			}
+			else if(diff < 0)
+			{
+				// Because of the scale used, the rx coordinate is always divisible
+				// by mx, so this will always come out even. The mx will always be
+				// nonzero because otherwise, the comparison would have been false.
+				ry -= my * (rx / mx);
+				rx = fullScale;
+				gx += stepX;
+			}
+			else
+			{
+				// Calculate how much x distance remains until the edge of the cell
+				// after moving forward to the edge in the y direction.
+				rx -= mx * (ry / my);
+				ry = fullScale;
+				gy += stepY;
+			}
+		}
+	}
+
+	// Each worker thread handles this many exact collision tests at a time.
+	const size_t CANDIDATE_BLOCK = 64;
 }
 
 
 // Initialize a collision set. The cell size and cell count should both be
-// powers of two; otherwise, they are rounded down to a power of two.
-CollisionSet::CollisionSet(unsigned cellSize, unsigned cellCount)
+// powers of two; otherwise, they are rounded down to a power of two. If
+// more than one level is given, each level of the grid has cells twice as
+// large as the level before it, and each object is stored only in the
+// finest level where it covers at most two cells in each direction. That
+// keeps very large objects from being added to many small cells.
+CollisionSet::CollisionSet(unsigned cellSize, unsigned cellCount, unsigned levels)
 {
 	// Right shift amount to convert from (x, y) location to grid (x, y).
-	SHIFT = 0u;
+	unsigned shift = 0u;
 	while(cellSize >>= 1u)
-		++SHIFT;
-	CELL_SIZE = (1u << SHIFT);
-	CELL_MASK = CELL_SIZE - 1u;
+		++shift;
+	CELL_SIZE = (1u << shift);
 
 	// Number of grid rows and columns.
 	CELLS = 1u;
@@ -86,6 +188,10 @@ CollisionSet::CollisionSet(unsigned cellSize, unsigned cellCount)
 		CELLS <<= 1;
 	WRAP_MASK = CELLS - 1u;
 
+	this->levels.resize(max(1u, levels));
+	for(Level &level : this->levels)
+		level.shift = shift++;
+
 	// Just in case Clear() isn't called before objects are added:
 	Clear(0);
 }
@@ -97,13 +203,16 @@ void CollisionSet::Clear(int step)
 {
 	this->step = step;
 
-	added.clear();
-	sorted.clear();
-	counts.clear();
 	all.clear();
-	// The counts vector starts with two sentinel slots that will be used in the
-	// course of performing the radix sort.
-	counts.resize(CELLS * CELLS + 2u, 0u);
+	for(Level &level : levels)
+	{
+		level.added.clear();
+		level.sorted.clear();
+		level.counts.clear();
+		// The counts vector starts with two sentinel slots that will be used in the
+		// course of performing the radix sort.
+		level.counts.resize(CELLS * CELLS + 2u, 0u);
+	}
 }
 
 
@@ -111,11 +220,18 @@ void CollisionSet::Clear(int step)
 // Add an object to the set.
 void CollisionSet::Add(Body &body)
 {
+	// Find the finest level of the grid where this object covers at most two
+	// cells in each direction.
+	size_t index = 0;
+	while(index + 1 < levels.size() && 2. * body.Radius() > (CELL_SIZE << index))
+		++index;
+	Level &level = levels[index];
+
 	// Calculate the range of (x, y) grid coordinates this object covers.
-	int minX = static_cast<int>(body.Position().X() - body.Radius()) >> SHIFT;
-	int minY = static_cast<int>(body.Position().Y() - body.Radius()) >> SHIFT;
-	int maxX = static_cast<int>(body.Position().X() + body.Radius()) >> SHIFT;
-	int maxY = static_cast<int>(body.Position().Y() + body.Radius()) >> SHIFT;
+	int minX = static_cast<int>(body.Position().X() - body.Radius()) >> level.shift;
+	int minY = static_cast<int>(body.Position().Y() - body.Radius()) >> level.shift;
+	int maxX = static_cast<int>(body.Position().X() + body.Radius()) >> level.shift;
+	int maxY = static_cast<int>(body.Position().Y() + body.Radius()) >> level.shift;
 
 	// Add a pointer to this object in every grid cell it occupies.
 	for(int y = minY; y <= maxY; ++y)
@@ -124,8 +240,8 @@ void CollisionSet::Add(Body &body)
 		for(int x = minX; x <= maxX; ++x)
 		{
 			auto gx = x & WRAP_MASK;
-			added.emplace_back(&body, all.size(), x, y);
-			++counts[gy * CELLS + gx + 2];
+			level.added.emplace_back(&body, all.size(), x, y);
+			++level.counts[gy * CELLS + gx + 2];
 		}
 	}
 
@@ -138,23 +254,26 @@ void CollisionSet::Add(Body &body)
 // Finish adding objects (and organize them into the final lookup table).
 void CollisionSet::Finish()
 {
-	// Perform a partial sum to convert the counts of items in each bin into the
-	// index of the output element where that bin begins.
-	partial_sum(counts.begin(), counts.end(), counts.begin());
+	for(Level &level : levels)
+	{
+		// Perform a partial sum to convert the counts of items in each bin into the
+		// index of the output element where that bin begins.
+		partial_sum(level.counts.begin(), level.counts.end(), level.counts.begin());
 
-	// Allocate space for a sorted copy of the vector.
-	sorted.resize(added.size());
+		// Allocate space for a sorted copy of the vector.
+		level.sorted.resize(level.added.size());
 
-	// Now, perform a radix sort.
-	for(const Entry &entry : added)
-	{
-		auto gx = entry.x & WRAP_MASK;
-		auto gy = entry.y & WRAP_MASK;
-		auto index = gy * CELLS + gx + 1;
+		// Now, perform a radix sort.
+		for(const Entry &entry : level.added)
+		{
+			auto gx = entry.x & WRAP_MASK;
+			auto gy = entry.y & WRAP_MASK;
+			auto index = gy * CELLS + gx + 1;
 
-		sorted[counts[index]++] = entry;
+			level.sorted[level.counts[index]++] = entry;
+		}
+		// Now, counts[index] is where a certain bin begins.
 	}
-	// Now, counts[index] is where a certain bin begins.
 
 	// Initialize 'seen' with 0
 	seen.clear();
@@ -184,160 +303,175 @@ Body *CollisionSet::Line(const Projectile &projectile, double *closestHit) const
 Body *CollisionSet::Line(const Point &from, const Point &to, double *closestHit,
 		const Government *pGov, const Body *target) const
 {
-	const int x = from.X();
-	const int y = from.Y();
-	const int endX = to.X();
-	const int endY = to.Y();
-
-	// Figure out which grid cell the line starts and ends in.
-	int gx = x >> SHIFT;
-	int gy = y >> SHIFT;
-	const int endGX = endX >> SHIFT;
-	const int endGY = endY >> SHIFT;
-
-	Closest closer_result(closestHit ? *closestHit : 1.);
+	// Cap projectile velocity to prevent integer overflows.
+	Point newEnd = to;
+	if(CapVelocity(from, newEnd))
+		return Line(from, newEnd, closestHit, pGov, target);
 
-	// Special case, very common: the projectile is contained in one grid cell.
-	// In this case, all the complicated code below can be skipped.
-	if(gx == endGX && gy == endGY)
+	// Each level of the grid is checked separately, and the closest collision
+	// in any of them is the one that counts.
+	const double start = closestHit ? *closestHit : 1.;
+	Closest closer_result(start);
+	for(const Level &level : levels)
 	{
-		// Examine all objects in the current grid cell.
-		const auto index = (gy & WRAP_MASK) * CELLS + (gx & WRAP_MASK);
-		vector<Entry>::const_iterator it = sorted.begin() + counts[index];
-		vector<Entry>::const_iterator end = sorted.begin() + counts[index + 1];
-		for( ; it != end; ++it)
-		{
-			// Skip objects that were put in this same grid cell only because
-			// of the cell coordinates wrapping around.
-			if(it->x != gx || it->y != gy)
-				continue;
+		if(level.added.empty())
+			continue;
 
-			// Check if this projectile can hit this object. If either the
-			// projectile or the object has no government, it will always hit.
-			const Government *iGov = it->body->GetGovernment();
-			if(it->body != target && iGov && pGov && !iGov->IsEnemy(pGov))
-				continue;
+		double distance = start;
+		Body *body = Line(level, from, to, distance, pGov, target);
+		if(body)
+			closer_result.TryNearer(distance, body);
+	}
 
-			const Mask &mask = it->body->GetMask(step);
-			Point offset = from - it->body->Position();
-			const double range = mask.Collide(offset, to - from, it->body->Facing());
+	if(closer_result.GetClosestDistance() < 1. && closestHit)
+		*closestHit = closer_result.GetClosestDistance();
+
+	return closer_result.GetClosestBody();
+}
 
-			closer_result.TryNearer(range, it->body);
-		}
-		if(closer_result.GetClosestDistance() < 1. && closestHit)
-			*closestHit = closer_result.GetClosestDistance();
 
-		return closer_result.GetClosestBody();
-	}
 
-	const Point pVelocity = (to - from);
-	if(pVelocity.Length() > MAX_VELOCITY)
+// Check a whole batch of projectiles at once. The result for each one is
+// the same as calling Line() for it, but the grid cells are only visited
+// once for all the projectiles that pass through them. If "parallel" is
+// set, the exact collision tests are spread across the worker threads.
+// Null entries in the batch are skipped.
+void CollisionSet::Lines(const vector<const Projectile *> &projectiles, vector<Collision> &collisions,
+	bool parallel) const
+{
+	collisions.clear();
+	collisions.resize(projectiles.size());
+
+	// Find each grid cell that each line passes through in each level of the
+	// grid, and count how many lines pass through each cell.
+	const unsigned cellsPerLevel = CELLS * CELLS;
+	lineEnds.resize(2 * projectiles.size());
+	queries.clear();
+	queryCounts.clear();
+	queryCounts.resize(levels.size() * cellsPerLevel + 2u, 0u);
+	for(unsigned line = 0; line < projectiles.size(); ++line)
 	{
-		// Cap projectile velocity to prevent integer overflows.
-		if(!warned)
-		{
-			Logger::LogError("Warning: maximum projectile velocity is " + to_string(MAX_VELOCITY));
-			warned = true;
-		}
-		Point newEnd = from + pVelocity.Unit() * USED_MAX_VELOCITY;
+		if(!projectiles[line])
+			continue;
 
-		return Line(from, newEnd, closestHit, pGov, target);
-	}
+		const Point &from = lineEnds[2 * line] = projectiles[line]->Position();
+		Point &to = lineEnds[2 * line + 1] = from + projectiles[line]->Velocity();
+		CapVelocity(from, to);
 
-	// When stepping from one grid cell to the next, we'll go in this direction.
-	const int stepX = (x <= endX ? 1 : -1);
-	const int stepY = (y <= endY ? 1 : -1);
-	// Calculate the slope of the line, shifted so it is positive in both axes.
-	const uint64_t mx = abs(endX - x);
-	const uint64_t my = abs(endY - y);
-	// Behave as if each grid cell has this width and height. This guarantees
-	// that we only need to work with integer coordinates.
-	const uint64_t scale = max<uint64_t>(mx, 1) * max<uint64_t>(my, 1);
-	const uint64_t fullScale = CELL_SIZE * scale;
-
-	// Get the "remainder" distance that we must travel in x and y in order to
-	// reach the next grid cell. These ensure we only check grid cells which the
-	// line will pass through.
-	uint64_t rx = scale * (x & CELL_MASK);
-	uint64_t ry = scale * (y & CELL_MASK);
-	if(stepX > 0)
-		rx = fullScale - rx;
-	if(stepY > 0)
-		ry = fullScale - ry;
+		for(unsigned level = 0; level < levels.size(); ++level)
+		{
+			if(levels[level].added.empty())
+				continue;
 
-	++seenEpoch;
+			unsigned order = 0;
+			WalkCells(from, to, levels[level].shift, [&](int cellX, int cellY) -> bool
+			{
+				const unsigned index = level * cellsPerLevel + (cellY & WRAP_MASK) * CELLS + (cellX & WRAP_MASK);
+				queries.emplace_back(level, index, cellX, cellY, line, order++);
+				++queryCounts[index + 2];
+				return false;
+			});
+		}
+	}
 
-	while(true)
+	// Sort the queries by grid cell, the same way as the objects are sorted.
+	partial_sum(queryCounts.begin(), queryCounts.end(), queryCounts.begin());
+	sortedQueries.resize(queries.size());
+	for(const CellQuery &query : queries)
+		sortedQueries[queryCounts[query.index + 1]++] = query;
+
+	// Now, pair up each line with every object in each cell that it passes
+	// through that it is able to hit. Objects that cover more than one of the
+	// cells are paired with the line once for each cell.
+	candidates.clear();
+	for(const CellQuery &query : sortedQueries)
 	{
-		// Examine all objects in the current grid cell.
-		auto i = (gy & WRAP_MASK) * CELLS + (gx & WRAP_MASK);
-		vector<Entry>::const_iterator it = sorted.begin() + counts[i];
-		vector<Entry>::const_iterator end = sorted.begin() + counts[i + 1];
-		for( ; it != end; ++it)
+		const Projectile &projectile = *projectiles[query.line];
+		const Government *pGov = projectile.GetGovernment();
+		const Body *target = projectile.Target();
+
+		const Level &level = levels[query.level];
+		const unsigned cell = query.index - query.level * cellsPerLevel;
+		for(unsigned entry = level.counts[cell]; entry < level.counts[cell + 1]; ++entry)
 		{
+			const Entry &it = level.sorted[entry];
 			// Skip objects that were put in this same grid cell only because
 			// of the cell coordinates wrapping around.
-			if(it->x != gx || it->y != gy)
-				continue;
-
-			if(seen[it->seenIndex] == seenEpoch)
+			if(it.x != query.x || it.y != query.y)
 				continue;
-			seen[it->seenIndex] = seenEpoch;
 
 			// Check if this projectile can hit this object. If either the
 			// projectile or the object has no government, it will always hit.
-			const Government *iGov = it->body->GetGovernment();
-			if(it->body != target && iGov && pGov && !iGov->IsEnemy(pGov))
+			const Government *iGov = it.body->GetGovernment();
+			if(it.body != target && iGov && pGov && !iGov->IsEnemy(pGov))
 				continue;
 
-			const Mask &mask = it->body->GetMask(step);
-			Point offset = from - it->body->Position();
-			const double range = mask.Collide(offset, to - from, it->body->Facing());
-
-			closer_result.TryNearer(range, it->body);
+			// Getting the mask may update the object's animation, so it must
+			// be done here rather than in the worker threads.
+			candidates.emplace_back(query.line, query.level, query.order, entry, it.body, &it.body->GetMask(step));
 		}
+	}
 
-		// Check if we've found a collision or reached the final grid cell.
-		if(closer_result.GetClosestBody() || (gx == endGX && gy == endGY))
-			break;
-		// If not, move to the next one. Check whether rx / mx < ry / my.
-		const int64_t diff = rx * my - ry * mx;
-		if(!diff)
+	// Do the exact collision test for each pair.
+	auto collide = [this](size_t i)
+	{
+		Candidate &candidate = candidates[i];
+		const Point &from = lineEnds[2 * candidate.line];
+		const Point &to = lineEnds[2 * candidate.line + 1];
+		Point offset = from - candidate.body->Position();
+		candidate.range = candidate.mask->Collide(offset, to - from, candidate.body->Facing());
+	};
+	if(parallel)
+	{
+		const size_t blocks = (candidates.size() + CANDIDATE_BLOCK - 1) / CANDIDATE_BLOCK;
+		WorkerPool::Run(blocks, [this, &collide](size_t block)
 		{
-			// The line is exactly intersecting a corner.
-			rx = fullScale;
-			ry = fullScale;
-			// Make sure we don't step past the end grid.
-			if(gx == endGX && gy + stepY == endGY)
-				break;
-			if(gy == endGY && gx + stepX == endGX)
-				break;
-			gx += stepX;
-			gy += stepY;
-		}
-		else if(diff < 0)
+			const size_t end = min(candidates.size(), (block + 1) * CANDIDATE_BLOCK);
+			for(size_t i = block * CANDIDATE_BLOCK; i < end; ++i)
+				collide(i);
+		});
+	}
+	else
+		for(size_t i = 0; i < candidates.size(); ++i)
+			collide(i);
+
+	// Within each level, a single Line() query stops at the first grid cell
+	// where it finds a collision, and picks the closest of the objects it
+	// checked there. To get the same result, prefer collisions in earlier
+	// cells, then closer ones, then ones with objects that come first in
+	// that cell.
+	const size_t none = candidates.size();
+	best.clear();
+	best.resize(projectiles.size() * levels.size(), none);
+	for(size_t i = 0; i < candidates.size(); ++i)
+	{
+		const Candidate &candidate = candidates[i];
+		if(candidate.range >= 1.)
+			continue;
+
+		size_t &current = best[candidate.line * levels.size() + candidate.level];
+		if(current == none)
 		{
-			// Because of the scale used, the rx coordinate is always divisible
-			// by mx, so this will always come out even. The mx will always be
-			// nonzero because otherwise, the comparison would have been false.
-			ry -= my * (rx / mx);
-			rx = fullScale;
-			gx += stepX;
+			current = i;
+			continue;
 		}
-		else
+		const Candidate &other = candidates[current];
+		if(candidate.order != other.order ? candidate.order < other.order
+				: candidate.range != other.range ? candidate.range < other.range
+				: candidate.entry < other.entry)
+			current = i;
+	}
+	// Then, pick the closest of the collisions found in each level.
+	for(size_t line = 0; line < projectiles.size(); ++line)
+		for(size_t level = 0; level < levels.size(); ++level)
 		{
-			// Calculate how much x distance remains until the edge of the cell
-			// after moving forward to the edge in the y direction.
-			rx -= mx * (ry / my);
-			ry = fullScale;
-			gy += stepY;
+			const size_t index = best[line * levels.size() + level];
+			if(index != none && candidates[index].range < collisions[line].distance)
+			{
+				collisions[line].body = candidates[index].body;
+				collisions[line].distance = candidates[index].range;
+			}
 		}
-	}
-
-	if(closer_result.GetClosestDistance() < 1. && closestHit)
-		*closestHit = closer_result.GetClosestDistance();
-
-	return closer_result.GetClosestBody();
 }
 
 
@@ -354,42 +488,48 @@ const vector<Body *> &CollisionSet::Circle(const Point &center, double radius) c
 // centered at the given point.
 const vector<Body *> &CollisionSet::Ring(const Point &center, double inner, double outer) const
 {
-	// Calculate the range of (x, y) grid coordinates this ring covers.
-	const int minX = static_cast<int>(center.X() - outer) >> SHIFT;
-	const int minY = static_cast<int>(center.Y() - outer) >> SHIFT;
-	const int maxX = static_cast<int>(center.X() + outer) >> SHIFT;
-	const int maxY = static_cast<int>(center.Y() + outer) >> SHIFT;
-
 	++seenEpoch;
 
 	result.clear();
-	for(int y = minY; y <= maxY; ++y)
+	for(const Level &level : levels)
 	{
-		const auto gy = y & WRAP_MASK;
-		for(int x = minX; x <= maxX; ++x)
-		{
-			const auto gx = x & WRAP_MASK;
-			const auto index = gy * CELLS + gx;
-			vector<Entry>::const_iterator it = sorted.begin() + counts[index];
-			vector<Entry>::const_iterator end = sorted.begin() + counts[index + 1];
+		if(level.added.empty())
+			continue;
+
+		// Calculate the range of (x, y) grid coordinates this ring covers.
+		const int minX = static_cast<int>(center.X() - outer) >> level.shift;
+		const int minY = static_cast<int>(center.Y() - outer) >> level.shift;
+		const int maxX = static_cast<int>(center.X() + outer) >> level.shift;
+		const int maxY = static_cast<int>(center.Y() + outer) >> level.shift;
 
-			for( ; it != end; ++it)
+		for(int y = minY; y <= maxY; ++y)
+		{
+			const auto gy = y & WRAP_MASK;
+			for(int x = minX; x <= maxX; ++x)
 			{
-				// Skip objects that were put in this same grid cell only because
-				// of the cell coordinates wrapping around.
-				if(it->x != x || it->y != y)
-					continue;
-
-				if(seen[it->seenIndex] == seenEpoch)
-					continue;
-				seen[it->seenIndex] = seenEpoch;
-
-				const Mask &mask = it->body->GetMask(step);
-				Point offset = center - it->body->Position();
-				const double length = offset.Length();
-				if((length <= outer && length >= inner)
-					|| mask.WithinRing(offset, it->body->Facing(), inner, outer))
-					result.push_back(it->body);
+				const auto gx = x & WRAP_MASK;
+				const auto index = gy * CELLS + gx;
+				vector<Entry>::const_iterator it = level.sorted.begin() + level.counts[index];
+				vector<Entry>::const_iterator end = level.sorted.begin() + level.counts[index + 1];
+
+				for( ; it != end; ++it)
+				{
+					// Skip objects that were put in this same grid cell only because
+					// of the cell coordinates wrapping around.
+					if(it->x != x || it->y != y)
+						continue;
+
+					if(seen[it->seenIndex] == seenEpoch)
+						continue;
+					seen[it->seenIndex] = seenEpoch;
+
+					const Mask &mask = it->body->GetMask(step);
+					Point offset = center - it->body->Position();
+					const double length = offset.Length();
+					if((length <= outer && length >= inner)
+						|| mask.WithinRing(offset, it->body->Facing(), inner, outer))
+						result.push_back(it->body);
+				}
 			}
 		}
 	}
@@ -402,3 +542,88 @@ const vector<Body *> &CollisionSet::All() const
 {
 	return all;
 }
+
+
+
+// Find the closest object in one level of the grid that collides with a
+// line, if it is closer than the given distance.
+Body *CollisionSet::Line(const Level &level, const Point &from, const Point &to, double &closest,
+		const Government *pGov, const Body *target) const
+{
+	// Figure out which grid cell the line starts and ends in.
+	const int gx = static_cast<int>(from.X()) >> level.shift;
+	const int gy = static_cast<int>(from.Y()) >> level.shift;
+	const int endGX = static_cast<int>(to.X()) >> level.shift;
+	const int endGY = static_cast<int>(to.Y()) >> level.shift;
+
+	Closest closer_result(closest);
+
+	// Special case, very common: the projectile is contained in one grid cell.
+	// In this case, all the complicated code below can be skipped.
+	if(gx == endGX && gy == endGY)
+	{
+		// Examine all objects in the current grid cell.
+		const auto index = (gy & WRAP_MASK) * CELLS + (gx & WRAP_MASK);
+		vector<Entry>::const_iterator it = level.sorted.begin() + level.counts[index];
+		vector<Entry>::const_iterator end = level.sorted.begin() + level.counts[index + 1];
+		for( ; it != end; ++it)
+		{
+			// Skip objects that were put in this same grid cell only because
+			// of the cell coordinates wrapping around.
+			if(it->x != gx || it->y != gy)
+				continue;
+
+			// Check if this projectile can hit this object. If either the
+			// projectile or the object has no government, it will always hit.
+			const Government *iGov = it->body->GetGovernment();
+			if(it->body != target && iGov && pGov && !iGov->IsEnemy(pGov))
+				continue;
+
+			const Mask &mask = it->body->GetMask(step);
+			Point offset = from - it->body->Position();
+			const double range = mask.Collide(offset, to - from, it->body->Facing());
+
+			closer_result.TryNearer(range, it->body);
+		}
+		closest = closer_result.GetClosestDistance();
+		return closer_result.GetClosestBody();
+	}
+
+	++seenEpoch;
+
+	WalkCells(from, to, level.shift, [&](int cellX, int cellY) -> bool
+	{
+		// Examine all objects in the current grid cell.
+		auto i = (cellY & WRAP_MASK) * CELLS + (cellX & WRAP_MASK);
+		vector<Entry>::const_iterator it = level.sorted.begin() + level.counts[i];
+		vector<Entry>::const_iterator end = level.sorted.begin() + level.counts[i + 1];
+		for( ; it != end; ++it)
+		{
+			// Skip objects that were put in this same grid cell only because
+			// of the cell coordinates wrapping around.
+			if(it->x != cellX || it->y != cellY)
+				continue;
+
+			if(seen[it->seenIndex] == seenEpoch)
+				continue;
+			seen[it->seenIndex] = seenEpoch;
+
+			// Check if this projectile can hit this object. If either the
+			// projectile or the object has no government, it will always hit.
+			const Government *iGov = it->body->GetGovernment();
+			if(it->body != target && iGov && pGov && !iGov->IsEnemy(pGov))
+				continue;
+
+			const Mask &mask = it->body->GetMask(step);
+			Point offset = from - it->body->Position();
+			const double range = mask.Collide(offset, to - from, it->body->Facing());
+
+			closer_result.TryNearer(range, it->body);
+		}
+		// Stop once a collision has been found.
+		return closer_result.GetClosestBody() != nullptr;
+	});
+
+	closest = closer_result.GetClosestDistance();
+	return closer_result.GetClosestBody();
+}
@@ -16,12 +16,15 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #ifndef COLLISION_SET_H_
 #define COLLISION_SET_H_
 
+#include "Point.h"
+
+#include <cstddef>
 #include <vector>
 
+class Body;
 class Government;
-class Point;
+class Mask;
 class Projectile;
-class Body;
 
 
 
@@ -29,10 +32,24 @@ class Body;
 // into a grid and keeping track of which objects are in each grid cell. A check
 // for collisions can then only examine objects in certain cells.
 class CollisionSet {
+public:
+	// The closest object that one line in a batch of queries collides with, if
+	// any, and how far along the line the collision happens.
+	class Collision {
+	public:
+		Body *body = nullptr;
+		double distance = 1.;
+	};
+
+
 public:
 	// Initialize a collision set. The cell size and cell count should both be
-	// powers of two; otherwise, they are rounded down to a power of two.
-	CollisionSet(unsigned cellSize, unsigned cellCount);
+	// powers of two; otherwise, they are rounded down to a power of two. If
+	// more than one level is given, each level of the grid has cells twice as
+	// large as the level before it, and each object is stored only in the
+	// finest level where it covers at most two cells in each direction. That
+	// keeps very large objects from being added to many small cells.
+	CollisionSet(unsigned cellSize, unsigned cellCount, unsigned levels = 1);
 
 	// Clear all objects in the set. Specify which engine step we are on, so we
 	// know what animation frame each object is on.
@@ -49,6 +66,13 @@ public:
 	// position or its entire expected trajectory (for the auto-firing AI).
 	Body *Line(const Point &from, const Point &to, double *closestHit = nullptr,
 		const Government *pGov = nullptr, const Body *target = nullptr) const;
+	// Check a whole batch of projectiles at once. The result for each one is
+	// the same as calling Line() for it, but the grid cells are only visited
+	// once for all the projectiles that pass through them. If "parallel" is
+	// set, the exact collision tests are spread across the worker threads.
+	// Null entries in the batch are skipped.
+	void Lines(const std::vector<const Projectile *> &projectiles, std::vector<Collision> &collisions,
+		bool parallel = false) const;
 
 	// Get all objects within the given range of the given point.
 	const std::vector<Body *> &Circle(const Point &center, double radius) const;
@@ -72,12 +96,59 @@ private:
 		int y;
 	};
 
+	// One level of the grid, holding the objects that are stored in it.
+	class Level {
+	public:
+		unsigned shift;
+		std::vector<Entry> added;
+		std::vector<Entry> sorted;
+		// After Finish(), counts[index] is where a certain bin begins.
+		std::vector<unsigned> counts;
+	};
+
+	// A grid cell that one line in a batch of queries passes through, and the
+	// order in which the line reaches that cell within its level of the grid.
+	class CellQuery {
+	public:
+		CellQuery() = default;
+		CellQuery(unsigned level, unsigned index, int x, int y, unsigned line, unsigned order)
+			: level(level), index(index), x(x), y(y), line(line), order(order) {}
+
+		unsigned level;
+		unsigned index;
+		int x;
+		int y;
+		unsigned line;
+		unsigned order;
+	};
+
+	// An object that one line in a batch of queries may collide with.
+	class Candidate {
+	public:
+		Candidate(unsigned line, unsigned level, unsigned order, unsigned entry, Body *body, const Mask *mask)
+			: line(line), level(level), order(order), entry(entry), body(body), mask(mask) {}
+
+		unsigned line;
+		unsigned level;
+		unsigned order;
+		// The index of the object within the sorted entries, to break ties.
+		unsigned entry;
+		Body *body;
+		const Mask *mask;
+		double range = 1.;
+	};
+
+
+private:
+	// Find the closest object in one level of the grid that collides with a
+	// line, if it is closer than the given distance.
+	Body *Line(const Level &level, const Point &from, const Point &to, double &closest,
+		const Government *pGov, const Body *target) const;
+
 
 private:
-	// The size of individual cells of the grid.
+	// The size of individual cells of the finest level of the grid.
 	unsigned CELL_SIZE;
-	unsigned SHIFT;
-	unsigned CELL_MASK;
 
 	// The number of grid cells.
 	unsigned CELLS;
@@ -88,10 +159,7 @@ private:
 
 	// Vectors to store the objects in the collision set.
 	std::vector<Body *> all;
-	std::vector<Entry> added;
-	std::vector<Entry> sorted;
-	// After Finish(), counts[index] is where a certain bin begins.
-	std::vector<unsigned> counts;
+	std::vector<Level> levels;
 
 	// Vector for returning the result of a circle query.
 	mutable std::vector<Body *> result;
@@ -99,6 +167,14 @@ private:
 	// Keep track of which objects we've already considered
 	mutable std::vector<unsigned> seen;
 	mutable unsigned seenEpoch = 0;
+
+	// Scratch space for batches of line queries.
+	mutable std::vector<Point> lineEnds;
+	mutable std::vector<CellQuery> queries;
+	mutable std::vector<CellQuery> sortedQueries;
+	mutable std::vector<unsigned> queryCounts;
+	mutable std::vector<Candidate> candidates;
+	mutable std::vector<size_t> best;
 };
 
 
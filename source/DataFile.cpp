@@ -15,11 +15,25 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "DataFile.h"
 
-#include "Files.h"
+#include "DataFileCache.h"
+#include "Logger.h"
+#include "MappedFile.h"
 #include "text/Utf8.h"
 
+#include <iterator>
+
 using namespace std;
 
+namespace {
+	// Get the next code point in the given text. The text is treated as if it
+	// always ends in a newline, so that the parser does not need to check for
+	// the end of the text separately from the end of a line.
+	char32_t Decode(const char *data, size_t end, size_t &pos)
+	{
+		return (pos < end) ? Utf8::DecodeCodePoint(data, end, pos) : '\n';
+	}
+}
+
 
 
 // Constructor, taking a file path (in UTF-8).
@@ -39,21 +53,27 @@ DataFile::DataFile(istream &in)
 
 
 // Load from a file path (in UTF-8).
-void DataFile::Load(const string &path)
+void DataFile::Load(const string &path, bool useCache, bool deferWarnings)
 {
-	string data = Files::Read(path);
-	if(data.empty())
+	if(useCache && DataFileCache::Read(path, root))
 		return;
 
-	// As a sentinel, make sure the file always ends in a newline.
-	if(data.back() != '\n')
-		data.push_back('\n');
+	// Map the file rather than copying it, if possible. Parsing it copies each
+	// token out of it, so the file is not needed after it has been parsed.
+	MappedFile file(path);
+	if(!file.Size())
+		return;
 
 	// Note what file this node is in, so it will show up in error traces.
 	root.tokens.push_back("file");
 	root.tokens.push_back(path);
 
-	LoadData(data);
+	// Files with warnings are not cached, so that the warnings are printed
+	// every time until the file is fixed.
+	if(LoadData(file.Data(), file.Size()) && useCache)
+		DataFileCache::Write(path, root);
+	if(!deferWarnings)
+		PrintWarnings();
 }
 
 
@@ -71,17 +91,25 @@ void DataFile::Load(istream &in)
 		in.read(&*data.begin() + currentSize, BLOCK);
 		data.resize(currentSize + in.gcount());
 	}
-	// As a sentinel, make sure the file always ends in a newline.
-	if(data.empty() || data.back() != '\n')
-		data.push_back('\n');
 
-	LoadData(data);
+	LoadData(data.data(), data.size());
+	PrintWarnings();
+}
+
+
+
+// Print any warnings from loading this file that have not been printed yet.
+void DataFile::PrintWarnings()
+{
+	for(const string &line : warnings)
+		Logger::LogError(line);
+	warnings.clear();
 }
 
 
 
 // Get an iterator to the start of the list of nodes in this file.
-list<DataNode>::const_iterator DataFile::begin() const
+vector<DataNode>::const_iterator DataFile::begin() const
 {
 	return root.begin();
 }
@@ -89,15 +117,16 @@ list<DataNode>::const_iterator DataFile::begin() const
 
 
 // Get an iterator to the end of the list of nodes in this file.
-list<DataNode>::const_iterator DataFile::end() const
+vector<DataNode>::const_iterator DataFile::end() const
 {
 	return root.end();
 }
 
 
 
-// Parse the given text.
-void DataFile::LoadData(const string &data)
+// Parse the given text, which does not need to end in a newline or a null
+// character. Return false if there were any warnings.
+bool DataFile::LoadData(const char *data, size_t end)
 {
 	// Keep track of the current stack of indentation levels and the most recent
 	// node at each level - that is, the node that will be the "parent" of any
@@ -106,14 +135,18 @@ void DataFile::LoadData(const string &data)
 	vector<int> separatorStack(1, -1);
 	bool fileIsTabs = false;
 	bool fileIsSpaces = false;
+	bool hasWarnings = false;
 	size_t lineNumber = 0;
+	// Each line is tokenized into this scratch list first, so that its strings
+	// (and their capacity) can be reused from one line to the next. Each node
+	// then only needs to allocate memory for tokens too long to store inline.
+	vector<string> lineTokens;
 
-	size_t end = data.length();
 	for(size_t pos = 0; pos < end; )
 	{
 		++lineNumber;
 		size_t tokenPos = pos;
-		char32_t c = Utf8::DecodeCodePoint(data, pos);
+		char32_t c = Decode(data, end, pos);
 
 		bool mixedIndentation = false;
 		int separators = 0;
@@ -134,16 +167,19 @@ void DataFile::LoadData(const string &data)
 
 			++separators;
 			tokenPos = pos;
-			c = Utf8::DecodeCodePoint(data, pos);
+			c = Decode(data, end, pos);
 		}
 
 		// If the line is a comment, skip to the end of the line.
 		if(c == '#')
 		{
 			if(mixedIndentation)
-				root.PrintTrace("Warning: Mixed whitespace usage for comment at line " + to_string(lineNumber));
+			{
+				Warn(root, "Warning: Mixed whitespace usage for comment at line " + to_string(lineNumber));
+				hasWarnings = true;
+			}
 			while(c != '\n')
-				c = Utf8::DecodeCodePoint(data, pos);
+				c = Decode(data, end, pos);
 		}
 		// Skip empty lines (including comment lines).
 		if(c == '\n')
@@ -158,8 +194,14 @@ void DataFile::LoadData(const string &data)
 		}
 
 		// Add this node as a child of the proper node.
-		list<DataNode> &children = stack.back()->children;
+		// Only the siblings of this node may be moved if this reallocates, and
+		// they have all been popped off the stack already. Moving a node does
+		// not keep its parent pointer, so theirs need to be set again.
+		vector<DataNode> &children = stack.back()->children;
+		bool reallocates = (children.size() == children.capacity());
 		children.emplace_back(stack.back());
+		if(reallocates)
+			stack.back()->Reparent();
 		DataNode &node = children.back();
 		node.lineNumber = lineNumber;
 
@@ -168,6 +210,8 @@ void DataFile::LoadData(const string &data)
 		separatorStack.push_back(separators);
 
 		// Tokenize the line. Skip comments and empty lines.
+		size_t tokenCount = 0;
+		bool missingQuote = false;
 		while(c != '\n')
 		{
 			// Check if this token begins with a quotation mark. If so, it will
@@ -177,7 +221,7 @@ void DataFile::LoadData(const string &data)
 			if(isQuoted)
 			{
 				tokenPos = pos;
-				c = Utf8::DecodeCodePoint(data, pos);
+				c = Decode(data, end, pos);
 			}
 
 			size_t endPos = tokenPos;
@@ -186,19 +230,14 @@ void DataFile::LoadData(const string &data)
 			while(c != '\n' && (isQuoted ? (c != endQuote) : (c > ' ')))
 			{
 				endPos = pos;
-				c = Utf8::DecodeCodePoint(data, pos);
+				c = Decode(data, end, pos);
 			}
 
-			// It ought to be legal to construct a string from an empty iterator
-			// range, but it appears that some libraries do not handle that case
-			// correctly. So:
-			if(tokenPos == endPos)
-				node.tokens.emplace_back();
-			else
-				node.tokens.emplace_back(data, tokenPos, endPos - tokenPos);
+			if(tokenCount == lineTokens.size())
+				lineTokens.emplace_back();
+			lineTokens[tokenCount++].assign(data + tokenPos, endPos - tokenPos);
 			// This is not a fatal error, but it may indicate a format mistake:
-			if(isQuoted && c == '\n')
-				node.PrintTrace("Warning: Closing quotation mark is missing:");
+			missingQuote |= (isQuoted && c == '\n');
 
 			if(c != '\n')
 			{
@@ -207,12 +246,12 @@ void DataFile::LoadData(const string &data)
 				if(isQuoted)
 				{
 					tokenPos = pos;
-					c = Utf8::DecodeCodePoint(data, pos);
+					c = Decode(data, end, pos);
 				}
 				while(c != '\n' && c <= ' ' && c != '#')
 				{
 					tokenPos = pos;
-					c = Utf8::DecodeCodePoint(data, pos);
+					c = Decode(data, end, pos);
 				}
 
 				// If a comment is encountered outside of a token, skip the rest
@@ -220,15 +259,34 @@ void DataFile::LoadData(const string &data)
 				if(c == '#')
 				{
 					while(c != '\n')
-						c = Utf8::DecodeCodePoint(data, pos);
+						c = Decode(data, end, pos);
 				}
 			}
 		}
-		// Now that we've reached the end of the line, we know no more tokens will be added to the node.
-		node.tokens.shrink_to_fit();
+		// Now that we've reached the end of the line, we know how many tokens
+		// this node has.
+		node.tokens.assign(lineTokens.begin(), lineTokens.begin() + tokenCount);
+		if(missingQuote)
+		{
+			Warn(node, "Warning: Closing quotation mark is missing:");
+			hasWarnings = true;
+		}
 
 		// Now that we've tokenized this node, print any mixed whitespace warnings.
 		if(mixedIndentation)
-			node.PrintTrace("Warning: Mixed whitespace usage at line");
+		{
+			Warn(node, "Warning: Mixed whitespace usage at line");
+			hasWarnings = true;
+		}
 	}
+	return !hasWarnings;
+}
+
+
+
+// Add a warning about the given node, to be printed later.
+void DataFile::Warn(const DataNode &node, const string &message)
+{
+	vector<string> lines = node.Trace(message);
+	warnings.insert(warnings.end(), make_move_iterator(lines.begin()), make_move_iterator(lines.end()));
 }
@@ -18,9 +18,10 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "DataNode.h"
 
+#include <cstddef>
 #include <istream>
-#include <list>
 #include <string>
+#include <vector>
 
 
 
@@ -37,21 +38,34 @@ public:
 	explicit DataFile(const std::string &path);
 	explicit DataFile(std::istream &in);
 
-	void Load(const std::string &path);
+	// If the cache is used and is turned on, an up to date copy of the file will
+	// be read from it instead of parsing the file, and any file that is parsed
+	// will be saved in it. Warnings about the file's formatting are printed
+	// right away, unless they are deferred until PrintWarnings() is called,
+	// e.g. so that files parsed in parallel print their warnings in order.
+	void Load(const std::string &path, bool useCache = false, bool deferWarnings = false);
 	void Load(std::istream &in);
+	// Print any warnings from loading this file that have not been printed yet.
+	void PrintWarnings();
 
 	// Functions for iterating through all DataNodes in this file.
-	std::list<DataNode>::const_iterator begin() const;
-	std::list<DataNode>::const_iterator end() const;
+	std::vector<DataNode>::const_iterator begin() const;
+	std::vector<DataNode>::const_iterator end() const;
 
 
 private:
-	void LoadData(const std::string &data);
+	// Parse the given text, which does not need to end in a newline or a null
+	// character. Return false if there were any warnings.
+	bool LoadData(const char *data, size_t end);
+	// Add a warning about the given node, to be printed later.
+	void Warn(const DataNode &node, const std::string &message);
 
 
 private:
 	// This is the container for all DataNodes in this file.
 	DataNode root;
+	// Lines of warnings that have not been printed yet.
+	std::vector<std::string> warnings;
 };
 
 
@@ -0,0 +1,207 @@
+/* DataFileCache.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "DataFileCache.h"
+
+#include "DataNode.h"
+#include "Files.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+	// Every cached file starts with this, followed by the version of the format.
+	// Change the version whenever the format changes, so that old files are ignored.
+	const string MAGIC = "ESDC";
+	const uint32_t VERSION = 2;
+
+	// The directory that cached files are kept in. If this is empty, the cache
+	// is turned off. It is only set before any data files are loaded.
+	string cacheDirectory;
+
+	// Get the path of the cached copy of the given file.
+	string CachePath(const string &path)
+	{
+		return Files::CachePath(cacheDirectory, path, ".bin");
+	}
+
+	// Read an integer that was written by Files::WriteInt().
+	bool ReadInt(const char *in, size_t size, size_t &pos, uint64_t &value, int bytes)
+	{
+		if(size - pos < static_cast<size_t>(bytes))
+			return false;
+
+		value = 0;
+		for(int i = 0; i < bytes; ++i)
+			value |= static_cast<uint64_t>(static_cast<unsigned char>(in[pos++])) << (8 * i);
+		return true;
+	}
+
+	void WriteString(string &out, const string &value)
+	{
+		Files::WriteInt(out, value.size(), 4);
+		out += value;
+	}
+
+	bool ReadString(const char *in, size_t size, size_t &pos, string &value)
+	{
+		uint64_t length = 0;
+		if(!ReadInt(in, size, pos, length, 4) || size - pos < length)
+			return false;
+
+		value.assign(in + pos, length);
+		pos += length;
+		return true;
+	}
+}
+
+
+
+// Store cached files in the given directory, creating it if necessary.
+void DataFileCache::Init(const string &directory)
+{
+	cacheDirectory = directory;
+	if(!cacheDirectory.empty() && cacheDirectory.back() != '/')
+		cacheDirectory += '/';
+	Files::CreateFolder(cacheDirectory);
+	if(!Files::Exists(cacheDirectory))
+		cacheDirectory.clear();
+}
+
+
+
+// Check whether the cache is turned on.
+bool DataFileCache::IsEnabled()
+{
+	return !cacheDirectory.empty();
+}
+
+
+
+// If there is an up to date copy of the given file in the cache, load it
+// into the given node (which should be empty) and return true.
+bool DataFileCache::Read(const string &path, DataNode &root)
+{
+	if(cacheDirectory.empty())
+		return false;
+
+	string cachePath = CachePath(path);
+	if(!Files::Exists(cachePath))
+		return false;
+
+	// The whole file is mapped at once, and then checked against the header
+	// that it would have if it were up to date.
+	MappedFile file(cachePath);
+	string header = Files::CacheHeader(MAGIC, VERSION, path);
+	if(file.Size() < header.size() || header.compare(0, header.size(), file.Data(), header.size()))
+		return false;
+
+	size_t pos = header.size();
+	if(ReadNode(file.Data(), file.Size(), pos, root) && pos == file.Size())
+		return true;
+
+	// If the cached copy is damaged, start over with an empty node.
+	root = DataNode();
+	return false;
+}
+
+
+
+// Save the given parsed file in the cache.
+void DataFileCache::Write(const string &path, const DataNode &root)
+{
+	if(cacheDirectory.empty())
+		return;
+
+	string out = Files::CacheHeader(MAGIC, VERSION, path);
+	WriteNode(out, root);
+	Files::WriteBinary(CachePath(path), out);
+}
+
+
+
+void DataFileCache::WriteNode(string &out, const DataNode &node)
+{
+	Files::WriteInt(out, node.lineNumber, 4);
+	Files::WriteInt(out, node.tokens.size(), 4);
+	for(size_t i = 0; i < node.tokens.size(); ++i)
+	{
+		WriteString(out, node.tokens[i]);
+		// Also store whether each token is a number, and if so its value, so
+		// that they do not need to be parsed again when the file is read back.
+		const DataNode::CachedValue &cached = node.Cached(i);
+		Files::WriteInt(out, cached.isNumber, 1);
+		if(cached.isNumber)
+		{
+			uint64_t bits = 0;
+			memcpy(&bits, &cached.value, sizeof(bits));
+			Files::WriteInt(out, bits, 8);
+		}
+	}
+	Files::WriteInt(out, node.children.size(), 4);
+	for(const DataNode &child : node.children)
+		WriteNode(out, child);
+}
+
+
+
+bool DataFileCache::ReadNode(const char *in, size_t size, size_t &pos, DataNode &node)
+{
+	uint64_t lineNumber = 0;
+	uint64_t tokens = 0;
+	if(!ReadInt(in, size, pos, lineNumber, 4) || !ReadInt(in, size, pos, tokens, 4))
+		return false;
+
+	node.lineNumber = lineNumber;
+	// Each token takes up at least five bytes, so a damaged count can be
+	// caught before it is used to allocate memory.
+	if(tokens > (size - pos) / 5)
+		return false;
+	node.tokens.resize(tokens);
+	node.values.resize(tokens);
+	for(size_t i = 0; i < tokens; ++i)
+	{
+		uint64_t isNumber = 0;
+		if(!ReadString(in, size, pos, node.tokens[i]) || !ReadInt(in, size, pos, isNumber, 1) || isNumber > 1)
+			return false;
+
+		DataNode::CachedValue &cached = node.values[i];
+		cached.isParsed = true;
+		cached.isNumber = isNumber;
+		if(cached.isNumber)
+		{
+			uint64_t bits = 0;
+			if(!ReadInt(in, size, pos, bits, 8))
+				return false;
+			memcpy(&cached.value, &bits, sizeof(bits));
+		}
+	}
+
+	// Likewise, each child takes up at least twelve bytes.
+	uint64_t children = 0;
+	if(!ReadInt(in, size, pos, children, 4) || children > (size - pos) / 12)
+		return false;
+	node.children.reserve(children);
+	for(uint64_t i = 0; i < children; ++i)
+	{
+		node.children.emplace_back(&node);
+		if(!ReadNode(in, size, pos, node.children.back()))
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,54 @@
+/* DataFileCache.h
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DATA_FILE_CACHE_H_
+#define DATA_FILE_CACHE_H_
+
+#include <cstddef>
+#include <string>
+
+class DataNode;
+
+
+
+// This class is a collection of global functions for keeping a copy of each
+// parsed data file on disk in a compact binary form, so that a file that has
+// not changed since it was last parsed can be read back without tokenizing it
+// again. Each copy remembers the path, size, and modification time of the file
+// that it was made from, and is ignored if any of those no longer match. The
+// cache is off until it is given a directory to use.
+class DataFileCache {
+public:
+	// Store cached files in the given directory, creating it if necessary.
+	static void Init(const std::string &directory);
+	// Check whether the cache is turned on.
+	static bool IsEnabled();
+
+	// If there is an up to date copy of the given file in the cache, load it
+	// into the given node (which should be empty) and return true.
+	static bool Read(const std::string &path, DataNode &root);
+	// Save the given parsed file in the cache.
+	static void Write(const std::string &path, const DataNode &root);
+
+
+private:
+	// Convert a node and all its children to or from their binary form.
+	static void WriteNode(std::string &out, const DataNode &node);
+	static bool ReadNode(const char *in, size_t size, size_t &pos, DataNode &node);
+};
+
+
+
+#endif
@@ -39,7 +39,7 @@ DataNode::DataNode(const DataNode *parent) noexcept(false)
 
 // Copy constructor.
 DataNode::DataNode(const DataNode &other)
-	: children(other.children), tokens(other.tokens), lineNumber(other.lineNumber)
+	: children(other.children), tokens(other.tokens), values(other.values), lineNumber(other.lineNumber)
 {
 	Reparent();
 }
@@ -51,6 +51,7 @@ DataNode &DataNode::operator=(const DataNode &other)
 {
 	children = other.children;
 	tokens = other.tokens;
+	values = other.values;
 	lineNumber = other.lineNumber;
 	Reparent();
 	return *this;
@@ -59,7 +60,8 @@ DataNode &DataNode::operator=(const DataNode &other)
 
 
 DataNode::DataNode(DataNode &&other) noexcept
-	: children(std::move(other.children)), tokens(std::move(other.tokens)), lineNumber(std::move(other.lineNumber))
+	: children(std::move(other.children)), tokens(std::move(other.tokens)), values(std::move(other.values)),
+	lineNumber(std::move(other.lineNumber))
 {
 	Reparent();
 }
@@ -70,6 +72,7 @@ DataNode &DataNode::operator=(DataNode &&other) noexcept
 {
 	children.swap(other.children);
 	tokens.swap(other.tokens);
+	values.swap(other.values);
 	lineNumber = std::move(other.lineNumber);
 	Reparent();
 	return *this;
@@ -108,10 +111,10 @@ double DataNode::Value(int index) const
 	// Check for empty strings and out-of-bounds indices.
 	if(static_cast<size_t>(index) >= tokens.size() || tokens[index].empty())
 		PrintTrace("Error: Requested token index (" + to_string(index) + ") is out of bounds:");
-	else if(!IsNumber(tokens[index]))
+	else if(!Cached(index).isNumber)
 		PrintTrace("Error: Cannot convert value \"" + tokens[index] + "\" to a number:");
 	else
-		return Value(tokens[index]);
+		return Cached(index).value;
 
 	return 0.;
 }
@@ -178,7 +181,7 @@ bool DataNode::IsNumber(int index) const
 	if(static_cast<size_t>(index) >= tokens.size() || tokens[index].empty())
 		return false;
 
-	return IsNumber(tokens[index]);
+	return Cached(index).isNumber;
 }
 
 
@@ -271,7 +274,7 @@ bool DataNode::HasChildren() const noexcept
 
 
 // Iterator to the beginning of the list of children.
-list<DataNode>::const_iterator DataNode::begin() const noexcept
+vector<DataNode>::const_iterator DataNode::begin() const noexcept
 {
 	return children.begin();
 }
@@ -279,7 +282,7 @@ list<DataNode>::const_iterator DataNode::begin() const noexcept
 
 
 // Iterator to the end of the list of children.
-list<DataNode>::const_iterator DataNode::end() const noexcept
+vector<DataNode>::const_iterator DataNode::end() const noexcept
 {
 	return children.end();
 }
@@ -288,15 +291,40 @@ list<DataNode>::const_iterator DataNode::end() const noexcept
 
 // Print a message followed by a "trace" of this node and its parents.
 int DataNode::PrintTrace(const string &message) const
+{
+	vector<string> lines;
+	size_t indent = AppendTrace(lines, message);
+	for(const string &line : lines)
+		Logger::LogError(line);
+
+	// Tell the caller what indentation level we're at now.
+	return indent;
+}
+
+
+
+// Get the lines that PrintTrace() would print, without printing them.
+vector<string> DataNode::Trace(const string &message) const
+{
+	vector<string> lines;
+	AppendTrace(lines, message);
+	return lines;
+}
+
+
+
+// Add the message and a line for this node and each of its parents to the
+// given trace, and return the indentation level of this node.
+size_t DataNode::AppendTrace(vector<string> &lines, const string &message) const
 {
 	if(!message.empty())
-		Logger::LogError(message);
+		lines.push_back(message);
 
-	// Recursively print all the parents of this node, so that the user can
-	// trace it back to the right point in the file.
+	// Recursively add all the parents of this node, so that the user can trace
+	// it back to the right point in the file.
 	size_t indent = 0;
 	if(parent)
-		indent = parent->PrintTrace() + 2;
+		indent = parent->AppendTrace(lines, "") + 2;
 	if(tokens.empty())
 		return indent;
 
@@ -315,11 +343,11 @@ int DataNode::PrintTrace(const string &message) const
 		if(hasSpace)
 			line += hasQuote ? '`' : '"';
 	}
-	Logger::LogError(line);
+	lines.push_back(std::move(line));
 
 	// Put an empty line in the log between each error message.
 	if(!message.empty())
-		Logger::LogError("");
+		lines.emplace_back();
 
 	// Tell the caller what indentation level we're at now.
 	return indent;
@@ -327,12 +355,32 @@ int DataNode::PrintTrace(const string &message) const
 
 
 
-// Adjust the parent pointers when a copy is made of a DataNode.
+// Get the parsed form of the token at the given index, which must exist.
+const DataNode::CachedValue &DataNode::Cached(int index) const
+{
+	// The tokens never change once a node has been loaded, so this only needs
+	// to be sized once.
+	if(values.size() != tokens.size())
+		values.resize(tokens.size());
+
+	CachedValue &cached = values[index];
+	if(!cached.isParsed)
+	{
+		cached.isParsed = true;
+		cached.isNumber = IsNumber(tokens[index]);
+		if(cached.isNumber)
+			cached.value = Value(tokens[index]);
+	}
+	return cached;
+}
+
+
+
+// Adjust the parent pointers when a copy is made of a DataNode. Only the
+// direct children need to be updated: each of them was itself either copied
+// (which reparented its own children) or moved along with its children.
 void DataNode::Reparent() noexcept
 {
 	for(DataNode &child : children)
-	{
 		child.parent = this;
-		child.Reparent();
-	}
 }
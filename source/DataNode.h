@@ -16,7 +16,6 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #ifndef DATA_NODE_H_
 #define DATA_NODE_H_
 
-#include <list>
 #include <string>
 #include <vector>
 
@@ -66,23 +65,44 @@ public:
 	// Check if this node has any children. If so, the iterator functions below
 	// can be used to access them.
 	bool HasChildren() const noexcept;
-	std::list<DataNode>::const_iterator begin() const noexcept;
-	std::list<DataNode>::const_iterator end() const noexcept;
+	std::vector<DataNode>::const_iterator begin() const noexcept;
+	std::vector<DataNode>::const_iterator end() const noexcept;
 
 	// Print a message followed by a "trace" of this node and its parents.
 	int PrintTrace(const std::string &message = "") const;
+	// Get the lines that PrintTrace() would print, without printing them.
+	std::vector<std::string> Trace(const std::string &message = "") const;
+
+
+private:
+	// The result of parsing one of this node's tokens as a number.
+	struct CachedValue {
+		double value = 0.;
+		// Whether the token has been parsed yet, and if so whether it is a number.
+		bool isParsed = false;
+		bool isNumber = false;
+	};
 
 
 private:
 	// Adjust the parent pointers when a copy is made of a DataNode.
 	void Reparent() noexcept;
+	// Get the parsed form of the token at the given index, which must exist.
+	const CachedValue &Cached(int index) const;
+	// Add the message and a line for this node and each of its parents to the
+	// given trace, and return the indentation level of this node.
+	size_t AppendTrace(std::vector<std::string> &lines, const std::string &message) const;
 
 
 private:
 	// These are "child" nodes found on subsequent lines with deeper indentation.
-	std::list<DataNode> children;
+	std::vector<DataNode> children;
 	// These are the tokens found in this particular line of the data file.
 	std::vector<std::string> tokens;
+	// Tokens are only parsed as numbers the first time that they are asked
+	// for, and then remembered so that repeated lookups do not parse them again.
+	// This is not safe if more than one thread reads the same node at once.
+	mutable std::vector<CachedValue> values;
 	// The parent pointer is used only for printing stack traces.
 	const DataNode *parent = nullptr;
 	// The line number in the given file that produced this node.
@@ -90,6 +110,7 @@ private:
 
 	// Allow DataFile to modify the internal structure of DataNodes.
 	friend class DataFile;
+	friend class DataFileCache;
 };
 
 
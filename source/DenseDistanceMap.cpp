@@ -0,0 +1,235 @@
+/* DenseDistanceMap.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "DenseDistanceMap.h"
+
+#include "Planet.h"
+#include "StellarObject.h"
+#include "System.h"
+#include "Wormhole.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+	// Without a ship to ask, assume the base game's fuel costs.
+	const int HYPERSPACE_FUEL = 100;
+	const int JUMP_FUEL = 200;
+	const double JUMP_RANGE = 100.;
+}
+
+
+
+// Find paths to the given system, potentially using wormholes, a jump drive,
+// or both. A maximum count above zero limits how many systems are returned,
+// and a maximum distance of zero or more limits how far away they can be.
+DenseDistanceMap::DenseDistanceMap(const System *center, WormholeStrategy wormholeStrategy,
+		bool useJumpDrive, int maxCount, int maxDistance)
+	: center(center), maxDistance(maxDistance), jumpFuel(useJumpDrive ? JUMP_FUEL : 0),
+		jumpRange(useJumpDrive ? JUMP_RANGE : 0.)
+{
+	if(center && center->Index() != System::NO_INDEX)
+		Init(wormholeStrategy, maxCount);
+}
+
+
+
+// Find out if the given system is reachable.
+bool DenseDistanceMap::HasRoute(const System *system) const
+{
+	return Find(system);
+}
+
+
+
+// Find out how many days away the given system is.
+int DenseDistanceMap::Days(const System *system) const
+{
+	const Edge *edge = Find(system);
+	return edge ? edge->days : -1;
+}
+
+
+
+// Starting in the given system, what is the next system along the route?
+const System *DenseDistanceMap::Route(const System *system) const
+{
+	const Edge *edge = Find(system);
+	return edge ? edge->next : nullptr;
+}
+
+
+
+// Get a set containing all the systems.
+set<const System *> DenseDistanceMap::Systems() const
+{
+	set<const System *> systems;
+	for(unsigned index : reached)
+		systems.insert(route[index].system);
+	return systems;
+}
+
+
+
+// Return the destination system - the 'center' system.
+const System *DenseDistanceMap::End() const
+{
+	return center;
+}
+
+
+
+int DenseDistanceMap::RequiredFuel(const System *system1, const System *system2) const
+{
+	const Edge *edge1 = Find(system1);
+	const Edge *edge2 = Find(system2);
+	if(!edge1 || !edge2)
+		return -1;
+	return abs(edge1->fuel - edge2->fuel);
+}
+
+
+
+// Sorting operator for the heap of edges waiting to be visited.
+bool DenseDistanceMap::Edge::operator<(const Edge &other) const
+{
+	if(fuel != other.fuel)
+		return (fuel > other.fuel);
+
+	if(days != other.days)
+		return (days > other.days);
+
+	return (danger > other.danger);
+}
+
+
+
+// Run the search outward from the center system. This follows the same steps
+// as DistanceMap::Init() does when it is not given a ship or a player, and the
+// heap is pushed and popped in the same order as its priority queue is.
+void DenseDistanceMap::Init(WormholeStrategy wormholeStrategy, int maxCount)
+{
+	Edge start;
+	start.system = center;
+	start.days = 0;
+	route.resize(center->Index() + 1);
+	route[center->Index()] = start;
+	reached.push_back(center->Index());
+	if(!maxDistance)
+		return;
+
+	start.next = center;
+	edges.push_back(start);
+	while(maxCount && !edges.empty())
+	{
+		pop_heap(edges.begin(), edges.end());
+		Edge top = edges.back();
+		edges.pop_back();
+
+		top.danger += top.next->Danger();
+		++top.days;
+
+		// Check for wormholes (which cost zero fuel).
+		if(wormholeStrategy != WormholeStrategy::NONE)
+			for(const StellarObject &object : top.next->Objects())
+				if(object.HasSprite() && object.HasValidPlanet() && object.GetPlanet()->IsWormhole()
+					&& (object.GetPlanet()->IsUnrestricted() || wormholeStrategy == WormholeStrategy::ALL))
+				{
+					const System &link = object.GetPlanet()->GetWormhole()->WormholeDestination(*top.next);
+					if(!HasBetter(link, top))
+						Add(link, top);
+				}
+
+		// Bail out if the maximum number of systems is reached.
+		if(!Propagate(top, false, maxCount))
+			break;
+		if(jumpFuel && !Propagate(top, true, maxCount))
+			break;
+	}
+	edges.clear();
+	edges.shrink_to_fit();
+}
+
+
+
+// Add the given links to the map. Return false if the maximum count is hit.
+bool DenseDistanceMap::Propagate(Edge edge, bool useJump, int &maxCount)
+{
+	edge.fuel += (useJump ? jumpFuel : HYPERSPACE_FUEL);
+	for(const System *link : (useJump ? edge.next->JumpNeighbors(jumpRange) : edge.next->Links()))
+	{
+		if(HasBetter(*link, edge))
+			continue;
+
+		Add(*link, edge);
+		if(!--maxCount)
+			return false;
+	}
+	return true;
+}
+
+
+
+// Check if we already have a better path to the given system. A system that
+// has no index can never be reached, so there is always a better path to it.
+// The same goes for a system whose index is already used by another system,
+// which can only happen if the systems are numbered during the search.
+bool DenseDistanceMap::HasBetter(const System &to, const Edge &edge) const
+{
+	unsigned index = to.Index();
+	if(index == System::NO_INDEX)
+		return true;
+	if(index >= route.size() || route[index].days < 0)
+		return false;
+
+	const Edge &best = route[index];
+	return (best.system != &to || !(best < edge));
+}
+
+
+
+// Add the given path to the record, and queue it if it may lead further.
+void DenseDistanceMap::Add(const System &to, Edge edge)
+{
+	unsigned index = to.Index();
+	if(index >= route.size())
+		route.resize(index + 1);
+	if(route[index].days < 0)
+		reached.push_back(index);
+
+	edge.system = &to;
+	route[index] = edge;
+	edge.next = &to;
+	if(maxDistance < 0 || edge.days < maxDistance)
+	{
+		edges.push_back(edge);
+		push_heap(edges.begin(), edges.end());
+	}
+}
+
+
+
+// Get the record for the given system, or null if it was not reached.
+const DenseDistanceMap::Edge *DenseDistanceMap::Find(const System *system) const
+{
+	// Each record says which system it belongs to, so a system that was given
+	// an index after this map was made is not mistaken for another one.
+	if(!system || system->Index() >= route.size())
+		return nullptr;
+	const Edge &edge = route[system->Index()];
+	return (edge.system == system ? &edge : nullptr);
+}
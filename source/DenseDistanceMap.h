@@ -0,0 +1,107 @@
+/* DenseDistanceMap.h
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DENSE_DISTANCE_MAP_H_
+#define DENSE_DISTANCE_MAP_H_
+
+#include "WormholeStrategy.h"
+
+#include <set>
+#include <vector>
+
+class System;
+
+
+
+// A DistanceMap for maps that do not depend on a player or a ship. Instead of
+// keying everything by System pointer, the results are kept in a flat array
+// indexed by each system's index. The systems waiting to be visited are kept
+// in a heap ordered the same way as DistanceMap's, so routes are chosen by the
+// same rules (lowest fuel, then fewest days, then least danger) and ties are
+// broken the same way. Systems that have not been given an index are never
+// reached, and since a system's index never changes once it is given, a map
+// stays valid for the systems that it reached when more systems are added.
+class DenseDistanceMap {
+public:
+	// Find paths to the given system, potentially using wormholes, a jump drive,
+	// or both. A maximum count above zero limits how many systems are returned,
+	// and a maximum distance of zero or more limits how far away they can be.
+	explicit DenseDistanceMap(const System *center, WormholeStrategy wormholeStrategy = WormholeStrategy::NONE,
+		bool useJumpDrive = false, int maxCount = -1, int maxDistance = -1);
+
+	// Find out if the given system is reachable.
+	bool HasRoute(const System *system) const;
+	// Find out how many days away the given system is.
+	int Days(const System *system) const;
+	// Starting in the given system, what is the next system along the route?
+	const System *Route(const System *system) const;
+
+	// Get a set containing all the systems.
+	std::set<const System *> Systems() const;
+	// Get the end of the route.
+	const System *End() const;
+
+	// How much fuel is needed to travel between two systems.
+	int RequiredFuel(const System *system1, const System *system2) const;
+
+
+private:
+	// The best known way to reach a system. A system has not been reached
+	// if its number of days is negative.
+	class Edge {
+	public:
+		// Sorting operator for the heap of edges waiting to be visited.
+		bool operator<(const Edge &other) const;
+
+		const System *system = nullptr;
+		const System *next = nullptr;
+		int fuel = 0;
+		int days = -1;
+		double danger = 0.;
+	};
+
+
+private:
+	// Run the search outward from the center system.
+	void Init(WormholeStrategy wormholeStrategy, int maxCount);
+	// Add the given links to the map. Return false if the maximum count is hit.
+	bool Propagate(Edge edge, bool useJump, int &maxCount);
+	// Check if we already have a better path to the given system.
+	bool HasBetter(const System &to, const Edge &edge) const;
+	// Add the given path to the record, and queue it if it may lead further.
+	void Add(const System &to, Edge edge);
+	// Get the record for the given system, or null if it was not reached.
+	const Edge *Find(const System *system) const;
+
+
+private:
+	// The route to each system, indexed by the system's index.
+	std::vector<Edge> route;
+	// The indices of every system that has been reached, in the order that
+	// they were first reached.
+	std::vector<unsigned> reached;
+
+	// A heap of the edges waiting to be visited.
+	std::vector<Edge> edges;
+
+	const System *center = nullptr;
+	int maxDistance = -1;
+	int jumpFuel = 0;
+	double jumpRange = 0.;
+};
+
+
+
+#endif
@@ -19,6 +19,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 using namespace std;
 
@@ -47,28 +48,63 @@ namespace {
 		return make_pair(low, false);
 	}
 
+	// Every interned string, and the index of each one that is used by a Key.
+	// These are only accessed while holding the mutex.
+	class Interned {
+	public:
+		mutex m;
+		set<string> strings;
+		unordered_map<const char *, size_t> keyIndex;
+	};
+
+	Interned &GetInterned()
+	{
+		static Interned interned;
+		return interned;
+	}
+
 	// String interning: return a pointer to a character string that matches the
 	// given string but has static storage duration.
 	const char *Intern(const char *key)
 	{
-		static set<string> interned;
-		static mutex m;
+		Interned &interned = GetInterned();
 
 		// Just in case this function is accessed from multiple threads:
-		lock_guard<mutex> lock(m);
-		return interned.insert(key).first->c_str();
+		lock_guard<mutex> lock(interned.m);
+		return interned.strings.insert(key).first->c_str();
 	}
 }
 
 
 
+Dictionary::Key::Key(const char *name)
+	: name(Intern(name))
+{
+	Interned &interned = GetInterned();
+
+	// If another Key already has this name, they share the same index.
+	lock_guard<mutex> lock(interned.m);
+	index = interned.keyIndex.emplace(this->name, interned.keyIndex.size()).first->second;
+}
+
+
+
+const char *Dictionary::Key::Name() const
+{
+	return name;
+}
+
+
+
 double &Dictionary::operator[](const char *key)
 {
 	pair<size_t, bool> pos = Search(key, *this);
 	if(pos.second)
 		return data()[pos.first].second;
 
-	return insert(begin() + pos.first, make_pair(Intern(key), 0.))->second;
+	insert(begin() + pos.first, make_pair(Intern(key), 0.));
+	FindKeys(pos.first);
+	return data()[pos.first].second;
 }
 
 
@@ -92,3 +128,35 @@ double Dictionary::Get(const string &key) const
 {
 	return Get(key.c_str());
 }
+
+
+
+// Update where the entry for each Key is, after an entry has been added at
+// the given index.
+void Dictionary::FindKeys(size_t added)
+{
+	Interned &interned = GetInterned();
+
+	lock_guard<mutex> lock(interned.m);
+	// If any keys were created since this was last done, start from scratch.
+	// All keys are interned, so they can be matched by their addresses.
+	if(keyEntries.size() != interned.keyIndex.size())
+	{
+		keyEntries.assign(interned.keyIndex.size(), 0);
+		for(size_t i = 0; i < size(); ++i)
+		{
+			auto it = interned.keyIndex.find(data()[i].first);
+			if(it != interned.keyIndex.end())
+				keyEntries[it->second] = i + 1;
+		}
+		return;
+	}
+
+	// Otherwise, every entry after the new one has moved down by one.
+	for(uint32_t &entry : keyEntries)
+		if(entry > added)
+			++entry;
+	auto it = interned.keyIndex.find(data()[added].first);
+	if(it != interned.keyIndex.end())
+		keyEntries[it->second] = added + 1;
+}
@@ -16,6 +16,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #ifndef DICTIONARY_H_
 #define DICTIONARY_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,6 +29,26 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 // compared to an STL map. That makes it suitable for ship attributes, which are
 // changed much less frequently than they are queried.
 class Dictionary : private std::vector<std::pair<const char *, double>> {
+public:
+	// A key that is looked up very often, such as a ship attribute that is
+	// checked every frame. Each Key is given its own index when it is created,
+	// and every dictionary keeps track of where each of those keys is stored,
+	// so getting the value of a Key does not involve any string comparisons.
+	// Keys should be created once, e.g. as constants, and never destroyed.
+	class Key {
+	public:
+		explicit Key(const char *name);
+
+		const char *Name() const;
+
+	private:
+		const char *name;
+		std::size_t index;
+
+		friend class Dictionary;
+	};
+
+
 public:
 	// Access a key for modifying it:
 	double &operator[](const char *key);
@@ -34,13 +56,40 @@ public:
 	// Get the value of a key, or 0 if it does not exist:
 	double Get(const char *key) const;
 	double Get(const std::string &key) const;
+	double Get(const Key &key) const;
 
 	// Expose certain functions from the underlying vector:
 	using std::vector<std::pair<const char *, double>>::empty;
 	using std::vector<std::pair<const char *, double>>::begin;
 	using std::vector<std::pair<const char *, double>>::end;
+
+
+private:
+	// Update where the entry for each Key is, after an entry has been added at
+	// the given index.
+	void FindKeys(std::size_t added);
+
+
+private:
+	// For each Key that existed when an entry was last added, this is one more
+	// than the index of that Key's entry, or 0 if it has no entry.
+	std::vector<uint32_t> keyEntries;
 };
 
 
 
+// Get the value of a key, or 0 if it does not exist. This is inline because
+// it is called so often.
+inline double Dictionary::Get(const Key &key) const
+{
+	if(key.index < keyEntries.size())
+	{
+		uint32_t entry = keyEntries[key.index];
+		return entry ? data()[entry - 1].second : 0.;
+	}
+	return Get(key.name);
+}
+
+
+
 #endif
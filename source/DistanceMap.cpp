@@ -15,6 +15,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "DistanceMap.h"
 
+#include "DenseDistanceMap.h"
 #include "Planet.h"
 #include "PlayerInfo.h"
 #include "Ship.h"
@@ -23,8 +24,35 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "System.h"
 #include "Wormhole.h"
 
+#include <mutex>
+#include <tuple>
+
 using namespace std;
 
+namespace {
+	// Maps are cached by their center and by the options they were made with.
+	using CacheKey = tuple<const System *, WormholeStrategy, bool, int, int>;
+	map<CacheKey, shared_ptr<const DenseDistanceMap>> cache;
+	// Missions and conditions may ask for maps from more than one thread.
+	mutex cacheMutex;
+
+	// If the cache grows beyond this many maps, start over rather than letting
+	// it grow without bound.
+	const size_t MAX_CACHED_MAPS = 512;
+}
+
+
+
+// Maps that do not depend on a player or a ship only change when the galaxy
+// does, so they are cached. Forget all of them. This must be done any time
+// the links between systems, their neighbors, or any wormholes change, and
+// any time a government becomes or stops being hostile to the player.
+void DistanceMap::ClearCache()
+{
+	lock_guard<mutex> lock(cacheMutex);
+	cache.clear();
+}
+
 
 
 // Find paths to the given system. If the given maximum count is above zero,
@@ -44,7 +72,30 @@ DistanceMap::DistanceMap(const System *center, WormholeStrategy wormholeStrategy
 	: center(center), wormholeStrategy(wormholeStrategy), maxCount(maxCount),
 			maxDistance(maxDistance), jumpFuel(useJumpDrive ? 200 : 0), jumpRange(useJumpDrive ? 100. : 0.)
 {
-	Init();
+	// A system that has not been numbered yet cannot be looked up in a dense map.
+	if(center && center->Index() == System::NO_INDEX)
+	{
+		Init();
+		return;
+	}
+
+	const CacheKey key(center, wormholeStrategy, useJumpDrive, maxCount, maxDistance);
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		auto it = cache.find(key);
+		if(it != cache.end())
+		{
+			dense = it->second;
+			return;
+		}
+	}
+
+	dense = make_shared<DenseDistanceMap>(center, wormholeStrategy, useJumpDrive, maxCount, maxDistance);
+
+	lock_guard<mutex> lock(cacheMutex);
+	if(cache.size() >= MAX_CACHED_MAPS)
+		cache.clear();
+	cache.emplace(key, dense);
 }
 
 
@@ -92,6 +143,8 @@ DistanceMap::DistanceMap(const Ship &ship, const System *destination)
 // Find out if the given system is reachable.
 bool DistanceMap::HasRoute(const System *system) const
 {
+	if(dense)
+		return dense->HasRoute(system);
 	return route.count(system);
 }
 
@@ -100,6 +153,8 @@ bool DistanceMap::HasRoute(const System *system) const
 // Find out how many days away the given system is.
 int DistanceMap::Days(const System *system) const
 {
+	if(dense)
+		return dense->Days(system);
 	auto it = route.find(system);
 	return (it == route.end() ? -1 : it->second.days);
 }
@@ -109,6 +164,8 @@ int DistanceMap::Days(const System *system) const
 // Starting in the given system, what is the next system along the route?
 const System *DistanceMap::Route(const System *system) const
 {
+	if(dense)
+		return dense->Route(system);
 	auto it = route.find(system);
 	return (it == route.end() ? nullptr : it->second.next);
 }
@@ -118,6 +175,8 @@ const System *DistanceMap::Route(const System *system) const
 // Get a set containing all the systems.
 set<const System *> DistanceMap::Systems() const
 {
+	if(dense)
+		return dense->Systems();
 	set<const System *> systems;
 	for(const auto &it : route)
 		systems.insert(it.first);
@@ -136,6 +195,8 @@ const System *DistanceMap::End() const
 
 int DistanceMap::RequiredFuel(const System *system1, const System *system2) const
 {
+	if(dense)
+		return dense->RequiredFuel(system1, system2);
 	auto it1 = route.find(system1);
 	auto it2 = route.find(system2);
 	if(it1 == route.end() || it2 == route.end())
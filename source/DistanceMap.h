@@ -19,10 +19,12 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "WormholeStrategy.h"
 
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <utility>
 
+class DenseDistanceMap;
 class PlayerInfo;
 class Ship;
 class System;
@@ -35,12 +37,20 @@ class System;
 // but can also travel to any of a system's "neighbors." A distance map can also
 // be used to calculate the shortest route between two systems.
 class DistanceMap {
+public:
+	// Maps that do not depend on a player or a ship only change when the galaxy
+	// does, so they are cached. Forget all of them. This must be done any time
+	// the links between systems, their neighbors, or any wormholes change, and
+	// any time a government becomes or stops being hostile to the player.
+	static void ClearCache();
+
+
 public:
 	// Find paths to the given system. The optional arguments put a limit on how
 	// many systems will be returned and how far away they are allowed to be.
 	explicit DistanceMap(const System *center, int maxCount = -1, int maxDistance = -1);
 	// Find paths to the given system, potentially using wormholes, a jump drive, or both.
-	// Optional arguments are as above.
+	// Optional arguments are as above. These maps are shared through a cache.
 	explicit DistanceMap(const System *center, WormholeStrategy wormholeStrategy,
 			bool useJumpDrive, int maxCount = -1, int maxDistance = -1);
 	// If a player is given, the map will only use hyperspace paths known to the
@@ -106,6 +116,8 @@ private:
 
 private:
 	std::map<const System *, Edge> route;
+	// Maps that do not depend on a player or a ship are looked up in here instead.
+	std::shared_ptr<const DenseDistanceMap> dense;
 
 	// Variables only used during construction:
 	std::priority_queue<Edge> edges;
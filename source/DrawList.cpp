@@ -32,6 +32,7 @@ using namespace std;
 void DrawList::Clear(int step, double zoom)
 {
 	items.clear();
+	sprites.clear();
 	this->step = step;
 	this->zoom = zoom;
 	isHighDPI = (Screen::IsHighResolution() ? zoom > .5 : zoom > 1.);
@@ -99,9 +100,15 @@ void DrawList::Draw() const
 {
 	SpriteShader::Bind();
 
+	// The textures are only looked up now, on the main thread, because that is
+	// the thread that loads and unloads them.
 	bool withBlur = Preferences::Has("Render motion blur");
-	for(const SpriteShader::Item &item : items)
+	for(size_t i = 0; i < items.size(); ++i)
+	{
+		SpriteShader::Item item = items[i];
+		item.texture = sprites[i]->Texture(isHighDPI);
 		SpriteShader::Add(item, withBlur);
+	}
 
 	SpriteShader::Unbind();
 }
@@ -135,7 +142,6 @@ void DrawList::Push(const Body &body, Point pos, Point blur, double cloak, int s
 {
 	SpriteShader::Item item;
 
-	item.texture = body.GetSprite()->Texture(isHighDPI);
 	item.frame = body.GetFrame(step);
 	item.frameCount = body.GetSprite()->Frames();
 
@@ -167,4 +173,5 @@ void DrawList::Push(const Body &body, Point pos, Point blur, double cloak, int s
 	item.clip = 1.;
 
 	items.push_back(item);
+	sprites.push_back(body.GetSprite());
 }
@@ -64,6 +64,9 @@ private:
 	double zoom = 1.;
 	bool isHighDPI = false;
 	std::vector<SpriteShader::Item> items;
+	// The sprite of each item. Their textures are not looked up until the
+	// items are drawn, because the list may be filled in a different thread.
+	std::vector<const Sprite *> sprites;
 
 	Point center;
 	Point centerVelocity;
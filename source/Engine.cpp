@@ -69,6 +69,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "TestContext.h"
 #include "Visual.h"
 #include "Weather.h"
+#include "WorkerPool.h"
 #include "Wormhole.h"
 #include "text/WrappedText.h"
 
@@ -120,24 +121,27 @@ namespace {
 	}
 
 	template <class Type>
-	void Prune(list<shared_ptr<Type>> &objects)
+	void Prune(vector<shared_ptr<Type>> &objects)
 	{
-		for(auto it = objects.begin(); it != objects.end(); )
-		{
-			if((*it)->ShouldBeRemoved())
-				it = objects.erase(it);
-			else
-				++it;
-		}
+		objects.erase(remove_if(objects.begin(), objects.end(),
+			[](const shared_ptr<Type> &object) { return object->ShouldBeRemoved(); }), objects.end());
 	}
 
-	template <class Type>
-	void Append(vector<Type> &objects, vector<Type> &added)
+	template <class Type, class Container>
+	void Append(vector<Type> &objects, Container &added)
 	{
 		objects.insert(objects.end(), make_move_iterator(added.begin()), make_move_iterator(added.end()));
 		added.clear();
 	}
 
+	// Check whether DoCollisions() needs to know which ship, if any, the given
+	// projectile has hit. Ship explosions always explode, and phasing
+	// projectiles only ever hit their own target.
+	bool NeedsShipCollision(const Projectile &projectile)
+	{
+		return projectile.GetGovernment() && !(projectile.GetWeapon().IsPhasing() && projectile.Target());
+	}
+
 
 	// Author the given message from the given ship.
 	void SendMessage(const shared_ptr<const Ship> &ship, const string &message)
@@ -237,13 +241,19 @@ namespace {
 
 	const double RADAR_SCALE = .025;
 	const double MAX_FUEL_DISPLAY = 5000.;
+	// Projectiles flying in a straight line are moved in blocks of this size,
+	// so that each worker thread has enough of them to be worth the overhead.
+	const size_t STRAIGHT_PROJECTILE_BLOCK = 1024;
+	// Ships range from tiny fighters to huge stations, so the collision set
+	// keeps them in a grid with cells from 256 up to 2048 units wide.
+	const unsigned SHIP_COLLISION_LEVELS = 4u;
 }
 
 
 
 Engine::Engine(PlayerInfo &player)
 	: player(player), ai(ships, asteroids.Minables(), flotsam),
-	ammoDisplay(player), shipCollisions(256u, 32u)
+	ammoDisplay(player), shipCollisions(256u, 32u, SHIP_COLLISION_LEVELS)
 {
 	zoom = Preferences::ViewZoom();
 
@@ -391,7 +401,7 @@ void Engine::Place()
 	}
 	// Move any ships that were randomly spawned into the main list, now
 	// that all special ships have been repositioned.
-	ships.splice(ships.end(), newShips);
+	Append(ships, newShips);
 
 	player.SetPlanet(nullptr);
 }
@@ -982,6 +992,19 @@ void Engine::Go()
 
 
 
+// Perform the next step of calculations on the calling thread instead of
+// the calculation thread. This is used to run the simulation without a
+// window, so the calculation thread must not be running.
+void Engine::Calculate()
+{
+	++step;
+	calcTickTock = !calcTickTock;
+	CalculateStep();
+	drawTickTock = calcTickTock;
+}
+
+
+
 // Pass the list of game events to MainPanel for handling by the player, and any
 // UI element generation.
 list<ShipEvent> &Engine::Events()
@@ -1235,6 +1258,26 @@ void Engine::BreakTargeting(const Government *gov)
 
 
 
+// Enable or disable measuring the time spent in each phase of the
+// calculation step. Enabling it resets all the measured times.
+void Engine::SetProfiling(bool enable)
+{
+	isProfiling = enable;
+	if(enable)
+		fill(begin(phaseTime), end(phaseTime), 0.);
+}
+
+
+
+// Get the total time, in seconds, spent in the given phase since profiling
+// was enabled.
+double Engine::ProfiledTime(Phase phase) const
+{
+	return phaseTime[static_cast<int>(phase)];
+}
+
+
+
 void Engine::EnterSystem()
 {
 	ai.Clean();
@@ -1421,7 +1464,10 @@ void Engine::CalculateStep()
 	// Handle the mouse input of the mouse navigation
 	HandleMouseInput(activeCommands);
 	// Now, all the ships must decide what they are doing next.
+	FrameTimer phaseTimer;
+	BeginPhase(phaseTimer);
 	ai.Step(player, activeCommands);
+	EndPhase(Phase::AI, phaseTimer);
 
 	// Clear the active players commands, they are all processed at this point.
 	activeCommands.Clear();
@@ -1440,8 +1486,10 @@ void Engine::CalculateStep()
 	const Ship *flagship = player.Flagship();
 	bool wasHyperspacing = (flagship && flagship->IsEnteringHyperspace());
 	// Move all the ships.
+	BeginPhase(phaseTimer);
 	for(const shared_ptr<Ship> &it : ships)
 		MoveShip(it);
+	EndPhase(Phase::MOVE_SHIPS, phaseTimer);
 	// If the flagship just began jumping, play the appropriate sound.
 	if(!wasHyperspacing && flagship && flagship->IsEnteringHyperspace())
 	{
@@ -1488,10 +1536,29 @@ void Engine::CalculateStep()
 		it->Move(newVisuals);
 	Prune(flotsam);
 
-	// Move the projectiles.
+	// Move the projectiles. Any that may steer or create effects or submunitions
+	// are moved in order, because they use random numbers. All the others fly in
+	// a straight line, and are moved afterwards in blocks that can be spread out
+	// across the worker threads.
+	BeginPhase(phaseTimer);
+	straightProjectiles.clear();
 	for(Projectile &projectile : projectiles)
-		projectile.Move(newVisuals, newProjectiles);
+	{
+		if(projectile.CanMoveStraight())
+			straightProjectiles.push_back(&projectile);
+		else
+			projectile.Move(newVisuals, newProjectiles);
+	}
+	const size_t straightCount = straightProjectiles.size();
+	const size_t blocks = (straightCount + STRAIGHT_PROJECTILE_BLOCK - 1) / STRAIGHT_PROJECTILE_BLOCK;
+	WorkerPool::Run(blocks, [this, straightCount](size_t block)
+	{
+		size_t end = min(straightCount, (block + 1) * STRAIGHT_PROJECTILE_BLOCK);
+		for(size_t i = block * STRAIGHT_PROJECTILE_BLOCK; i < end; ++i)
+			straightProjectiles[i]->MoveStraight();
+	});
 	Prune(projectiles);
+	EndPhase(Phase::MOVE_PROJECTILES, phaseTimer);
 
 	// Step the weather.
 	for(Weather &weather : activeWeather)
@@ -1515,9 +1582,9 @@ void Engine::CalculateStep()
 	// be drawn this step (and the projectiles will participate in collision
 	// detection) but they should not be moved, which is why we put off adding
 	// them to the lists until now.
-	ships.splice(ships.end(), newShips);
+	Append(ships, newShips);
 	Append(projectiles, newProjectiles);
-	flotsam.splice(flotsam.end(), newFlotsam);
+	Append(flotsam, newFlotsam);
 	Append(visuals, newVisuals);
 
 	// Decrement the count of how long it's been since a ship last asked for help.
@@ -1525,11 +1592,21 @@ void Engine::CalculateStep()
 		--grudgeTime;
 
 	// Populate the collision detection lookup sets.
+	BeginPhase(phaseTimer);
 	FillCollisionSets();
+	EndPhase(Phase::FILL_COLLISION_SETS, phaseTimer);
 
-	// Perform collision detection.
-	for(Projectile &projectile : projectiles)
-		DoCollisions(projectile);
+	// Perform collision detection. Which ship each projectile hits does not
+	// depend on what any other projectile has hit, so find those for all the
+	// projectiles at once.
+	BeginPhase(phaseTimer);
+	shipQueries.clear();
+	for(const Projectile &projectile : projectiles)
+		shipQueries.push_back(NeedsShipCollision(projectile) ? &projectile : nullptr);
+	shipCollisions.Lines(shipQueries, shipHits, true);
+	for(size_t i = 0; i < projectiles.size(); ++i)
+		DoCollisions(projectiles[i], shipHits[i]);
+	EndPhase(Phase::DO_COLLISIONS, phaseTimer);
 	// Now that collision detection is done, clear the cache of ships with anti-
 	// missile systems ready to fire.
 	hasAntiMissile.clear();
@@ -1559,9 +1636,12 @@ void Engine::CalculateStep()
 	radar[calcTickTock].SetCenter(newCenter);
 
 	// Populate the radar.
+	BeginPhase(phaseTimer);
 	FillRadar();
+	EndPhase(Phase::FILL_RADAR, phaseTimer);
 
 	// Draw the planets.
+	BeginPhase(phaseTimer);
 	for(const StellarObject &object : playerSystem->Objects())
 		if(object.HasSprite())
 		{
@@ -1629,6 +1709,7 @@ void Engine::CalculateStep()
 	// Draw the visuals.
 	for(const Visual &visual : visuals)
 		batchDraw[calcTickTock].AddVisual(visual);
+	EndPhase(Phase::ADD_SPRITES, phaseTimer);
 
 	// Keep track of how much of the CPU time we are using.
 	loadSum += loadTimer.Time();
@@ -2106,10 +2187,11 @@ void Engine::HandleMouseInput(Command &activeCommands)
 
 
 
-// Perform collision detection. Note that unlike the preceding functions, this
-// one adds any visuals that are created directly to the main visuals list. If
-// this is multi-threaded in the future, that will need to change.
-void Engine::DoCollisions(Projectile &projectile)
+// Perform collision detection, given the ship (if any) that this projectile
+// collides with. Note that unlike the preceding functions, this one adds any
+// visuals that are created directly to the main visuals list. If this is
+// multi-threaded in the future, that will need to change.
+void Engine::DoCollisions(Projectile &projectile, const CollisionSet::Collision &shipHit)
 {
 	// The asteroids can collide with projectiles, the same as any other
 	// object. If the asteroid turns out to be closer than the ship, it
@@ -2151,14 +2233,12 @@ void Engine::DoCollisions(Projectile &projectile)
 				}
 
 		// If nothing triggered the projectile, check for collisions with ships.
-		if(closestHit > 0.)
+		if(closestHit > 0. && shipHit.body)
 		{
-			Ship *ship = reinterpret_cast<Ship *>(shipCollisions.Line(projectile, &closestHit));
-			if(ship)
-			{
-				hit = ship->shared_from_this();
-				hitVelocity = ship->Velocity();
-			}
+			Ship *ship = reinterpret_cast<Ship *>(shipHit.body);
+			closestHit = shipHit.distance;
+			hit = ship->shared_from_this();
+			hitVelocity = ship->Velocity();
 		}
 		// "Phasing" projectiles can pass through asteroids. For all other
 		// projectiles, check if they've hit an asteroid that is closer than any
@@ -2635,3 +2715,21 @@ void Engine::EmplaceStatusOverlay(const shared_ptr<Ship> &it, Preferences::Overl
 	statuses.emplace_back(it->Position() - center, it->Shields(), it->Hull(),
 		min(it->Hull(), it->DisabledHull()), max(20., width * .5), type);
 }
+
+
+
+// If profiling, start timing a phase of the calculation step.
+void Engine::BeginPhase(FrameTimer &timer) const
+{
+	if(isProfiling)
+		timer = FrameTimer();
+}
+
+
+
+// If profiling, add the time elapsed since BeginPhase() to the given phase.
+void Engine::EndPhase(Phase phase, const FrameTimer &timer)
+{
+	if(isProfiling)
+		phaseTime[static_cast<int>(phase)] += timer.Time();
+}
@@ -42,6 +42,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 class AlertLabel;
 class Flotsam;
+class FrameTimer;
 class Government;
 class NPC;
 class Outfit;
@@ -65,6 +66,20 @@ class Weather;
 // lag is too small to be detectable and means that the game can better handle
 // situations where there are many objects on screen at once.
 class Engine {
+public:
+	// The phases of a calculation step whose run time can be profiled.
+	enum class Phase : int {
+		AI,
+		MOVE_SHIPS,
+		MOVE_PROJECTILES,
+		FILL_COLLISION_SETS,
+		DO_COLLISIONS,
+		FILL_RADAR,
+		ADD_SPRITES,
+		COUNT
+	};
+
+
 public:
 	explicit Engine(PlayerInfo &player);
 	~Engine();
@@ -81,6 +96,10 @@ public:
 	void Step(bool isActive);
 	// Begin the next step of calculations.
 	void Go();
+	// Perform the next step of calculations on the calling thread instead of
+	// the calculation thread. This is used to run the simulation without a
+	// window, so the calculation thread must not be running.
+	void Calculate();
 
 	// Get any special events that happened in this step.
 	// MainPanel::Step will clear this list.
@@ -102,6 +121,13 @@ public:
 	// projectiles stop targeting gov.
 	void BreakTargeting(const Government *gov);
 
+	// Enable or disable measuring the time spent in each phase of the
+	// calculation step. Enabling it resets all the measured times.
+	void SetProfiling(bool enable);
+	// Get the total time, in seconds, spent in the given phase since profiling
+	// was enabled.
+	double ProfiledTime(Phase phase) const;
+
 
 private:
 	class Target {
@@ -148,7 +174,7 @@ private:
 
 	void FillCollisionSets();
 
-	void DoCollisions(Projectile &projectile);
+	void DoCollisions(Projectile &projectile, const CollisionSet::Collision &shipHit);
 	void DoWeather(Weather &weather);
 	void DoCollection(Flotsam &flotsam);
 	void DoScanning(const std::shared_ptr<Ship> &ship);
@@ -162,20 +188,25 @@ private:
 	void CreateStatusOverlays();
 	void EmplaceStatusOverlay(const std::shared_ptr<Ship> &ship, Preferences::OverlayState overlaySetting, int value);
 
+	void BeginPhase(FrameTimer &timer) const;
+	void EndPhase(Phase phase, const FrameTimer &timer);
+
 
 private:
 	PlayerInfo &player;
 
-	std::list<std::shared_ptr<Ship>> ships;
+	AI::List<Ship> ships;
 	std::vector<Projectile> projectiles;
 	std::vector<Weather> activeWeather;
-	std::list<std::shared_ptr<Flotsam>> flotsam;
+	AI::List<Flotsam> flotsam;
 	std::vector<Visual> visuals;
 	AsteroidField asteroids;
 
 	// New objects created within the latest step:
 	std::list<std::shared_ptr<Ship>> newShips;
 	std::vector<Projectile> newProjectiles;
+	// Projectiles that only have to fly in a straight line this step.
+	std::vector<Projectile *> straightProjectiles;
 	std::list<std::shared_ptr<Flotsam>> newFlotsam;
 	std::vector<Visual> newVisuals;
 
@@ -230,6 +261,9 @@ private:
 	int grudgeTime = 0;
 
 	CollisionSet shipCollisions;
+	// The projectiles to check against the ship collision set, and the results.
+	std::vector<const Projectile *> shipQueries;
+	std::vector<CollisionSet::Collision> shipHits;
 
 	int alarmTime = 0;
 	double flash = 0.;
@@ -271,6 +305,10 @@ private:
 	double load = 0.;
 	int loadCount = 0;
 	double loadSum = 0.;
+
+	// Time spent in each phase of the calculation step, if profiling.
+	bool isProfiling = false;
+	double phaseTime[static_cast<int>(Phase::COUNT)] = {};
 };
 
 
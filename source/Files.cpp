@@ -446,6 +446,38 @@ time_t Files::Timestamp(const string &filePath)
 
 
 
+// Get the size of the given file in bytes, or 0 if it does not exist.
+size_t Files::Size(const string &filePath)
+{
+#if defined _WIN32
+	struct _stat buf;
+	if(_wstat(Utf8::ToUTF16(filePath).c_str(), &buf))
+		return 0;
+#else
+	struct stat buf;
+	if(stat(filePath.c_str(), &buf))
+		return 0;
+#endif
+	return buf.st_size;
+}
+
+
+
+// Create the given directory, if it does not already exist. The directory
+// that contains it must already exist.
+void Files::CreateFolder(const string &path)
+{
+	if(Exists(path))
+		return;
+#if defined _WIN32
+	CreateDirectoryW(Utf8::ToUTF16(path).c_str(), nullptr);
+#else
+	mkdir(path.c_str(), 0700);
+#endif
+}
+
+
+
 void Files::Copy(const string &from, const string &to)
 {
 #if defined _WIN32
@@ -532,9 +564,6 @@ string Files::Read(FILE *file)
 	size_t start = ftell(file);
 	fseek(file, 0, SEEK_END);
 	size_t size = ftell(file) - start;
-	// Reserve one extra byte because DataFile appends a '\n' to the end of each
-	// file it reads, and that's the most common use of this function.
-	result.reserve(size + 1);
 	result.resize(size);
 	fseek(file, start, SEEK_SET);
 
@@ -566,6 +595,75 @@ void Files::Write(FILE *file, const string &data)
 
 
 
+// Write the given data to a file exactly as it is. Unlike Write(), this
+// never converts line endings, even on Windows. The data is written to a
+// temporary file first, which then replaces the file, so anything reading the
+// file never sees it only partly written.
+void Files::WriteBinary(const string &path, const string &data)
+{
+	const string temporary = path + ".tmp";
+	FILE *file = nullptr;
+#if defined _WIN32
+	_wfopen_s(&file, Utf8::ToUTF16(temporary).c_str(), L"wb");
+#else
+	file = fopen(temporary.c_str(), "wb");
+#endif
+	if(!file)
+		return;
+
+	bool written = (fwrite(data.data(), 1, data.size(), file) == data.size());
+	written &= (fclose(file) == 0);
+	if(written)
+		Move(temporary, path);
+	else
+		Delete(temporary);
+}
+
+
+
+// Get the path in the given cache directory of the cached copy of the given file.
+string Files::CachePath(const string &directory, const string &path, const string &extension)
+{
+	// Name each cached copy after a hash (64-bit FNV-1a) of the full path of
+	// the file that it was made from. The path is also stored in the header, so
+	// a collision just means that one of the two files is not cached.
+	uint64_t hash = 14695981039346656037ull;
+	for(char c : path)
+		hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+
+	char name[17];
+	snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+	return directory + name + extension;
+}
+
+
+
+// Get the header that a cached copy of the given file should start with. The
+// magic string and version identify the format of the cached copy, so change
+// the version whenever the format changes and old copies will be ignored.
+string Files::CacheHeader(const string &magic, uint32_t version, const string &path)
+{
+	string header = magic;
+	WriteInt(header, version, 4);
+	WriteInt(header, Size(path), 8);
+	WriteInt(header, static_cast<int64_t>(Timestamp(path)), 8);
+	WriteInt(header, path.size(), 4);
+	header += path;
+	return header;
+}
+
+
+
+// Append an integer to binary data, in little-endian order and using the
+// given number of bytes.
+void Files::WriteInt(string &out, uint64_t value, int bytes)
+{
+	for(int i = 0; i < bytes; ++i)
+		out += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+
+
 // Open this user's plugins directory in their native file explorer.
 void Files::OpenUserPluginFolder()
 {
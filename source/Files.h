@@ -16,6 +16,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #ifndef ES_FILES_H_
 #define ES_FILES_H_
 
+#include <cstdint>
 #include <cstdio>
 #include <ctime>
 #include <string>
@@ -55,6 +56,11 @@ public:
 
 	static bool Exists(const std::string &filePath);
 	static std::time_t Timestamp(const std::string &filePath);
+	// Get the size of the given file in bytes, or 0 if it does not exist.
+	static size_t Size(const std::string &filePath);
+	// Create the given directory, if it does not already exist. The directory
+	// that contains it must already exist.
+	static void CreateFolder(const std::string &path);
 	static void Copy(const std::string &from, const std::string &to);
 	static void Move(const std::string &from, const std::string &to);
 	static void Delete(const std::string &filePath);
@@ -68,6 +74,23 @@ public:
 	static std::string Read(FILE *file);
 	static void Write(const std::string &path, const std::string &data);
 	static void Write(FILE *file, const std::string &data);
+	// Write the given data to a file exactly as it is. Unlike Write(), this
+	// never converts line endings, even on Windows. The data is written to a
+	// temporary file first, which then replaces the file, so anything reading the
+	// file never sees it only partly written.
+	static void WriteBinary(const std::string &path, const std::string &data);
+
+	// Files derived from other files, such as parsed data files or decoded
+	// images, can be cached on disk. Each cached copy is named after a hash of
+	// the path of the file that it was made from, and starts with a header that
+	// changes if that file changes in any way.
+	static std::string CachePath(const std::string &directory, const std::string &path,
+		const std::string &extension);
+	static std::string CacheHeader(const std::string &magic, uint32_t version, const std::string &path);
+	// Append an integer to binary data, in little-endian order and using the
+	// given number of bytes, so that it does not depend on the machine that
+	// wrote it.
+	static void WriteInt(std::string &out, uint64_t value, int bytes);
 
 	// Open this user's plugins directory in their native file explorer.
 	static void OpenUserPluginFolder();
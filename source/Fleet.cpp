@@ -22,6 +22,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Phrase.h"
 #include "pi.h"
 #include "Planet.h"
+#include "Pool.h"
 #include "Random.h"
 #include "Ship.h"
 #include "ShipJumpNavigation.h"
@@ -467,7 +468,7 @@ vector<shared_ptr<Ship>> Fleet::Instantiate(const vector<const Ship *> &ships) c
 		}
 
 		// Copy the model instance into a new instance.
-		auto ship = make_shared<Ship>(*model);
+		auto ship = Pool<Ship>::Make(*model);
 
 		const Phrase *phrase = ((ship->CanBeCarried() && fighterNames) ? fighterNames : names);
 		if(phrase)
@@ -25,6 +25,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "DataFile.h"
 #include "DataNode.h"
 #include "DataWriter.h"
+#include "DistanceMap.h"
 #include "Effect.h"
 #include "Files.h"
 #include "FillShader.h"
@@ -68,6 +69,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -94,6 +96,12 @@ namespace {
 	vector<string> sources;
 	map<const Sprite *, shared_ptr<ImageSet>> deferred;
 	map<const Sprite *, int> preloaded;
+#ifndef ES_NO_THREADS
+	// Sprites may be preloaded from more than one thread.
+	mutex preloadMutex;
+#endif // ES_NO_THREADS
+	// Whether sprites other than landscapes are loaded only once they are drawn.
+	bool loadSpritesOnDemand = false;
 
 	MaskManager maskManager;
 
@@ -102,6 +110,13 @@ namespace {
 
 	ConditionsStore globalConditions;
 
+	// Check whether the sprite with the given name is shown on the main menu,
+	// or on the interface panels that can be opened from it.
+	bool IsNeededForMenu(const string &name)
+	{
+		return !name.compare(0, 6, "_menu/") || !name.compare(0, 3, "ui/");
+	}
+
 	void LoadPlugin(const string &path)
 	{
 		const auto *plugin = Plugins::Load(path);
@@ -133,14 +148,19 @@ namespace {
 
 
 #ifndef ES_NO_THREADS
-future<void> GameData::BeginLoad(bool onlyLoadData, bool debugMode)
+future<void> GameData::BeginLoad(bool onlyLoadData, bool debugMode, bool preventUpload)
 #else
-void GameData::BeginLoad(bool onlyLoadData, bool debugMode)
+void GameData::BeginLoad(bool onlyLoadData, bool debugMode, bool preventUpload)
 #endif // ES_NO_THREADS
 {
 	// Initialize the list of "source" folders based on any active plugins.
 	LoadSources();
 
+	if(preventUpload)
+		spriteQueue.DisableUpload();
+	// Without textures, there is nothing to gain by loading sprites on demand.
+	bool onDemand = loadSpritesOnDemand && !preventUpload;
+
 	if(!onlyLoadData)
 	{
 		// Now, read all the images in all the path directories. For each unique
@@ -158,10 +178,11 @@ void GameData::BeginLoad(bool onlyLoadData, bool debugMode)
 			// Reduce the set of images to those that are valid.
 			it.second->ValidateFrames();
 			// For landscapes, remember all the source files but don't load them yet.
-			if(ImageSet::IsDeferred(it.first))
+			// The same goes for any other sprites that are loaded on demand.
+			if(ImageSet::IsDeferred(it.first) || (onDemand && spriteQueue.LoadOnDemand(it.second)))
 				deferred[SpriteSet::Get(it.first)] = it.second;
 			else
-				spriteQueue.Add(it.second);
+				spriteQueue.Add(it.second, IsNeededForMenu(it.first));
 		}
 
 		// Generate a catalog of music files.
@@ -173,6 +194,17 @@ void GameData::BeginLoad(bool onlyLoadData, bool debugMode)
 
 
 
+// Only load sprites once they are first drawn, and unload the ones that
+// have not been drawn for a while once they use more than the given number
+// of megabytes of texture memory. This must be called before BeginLoad().
+void GameData::LoadSpritesOnDemand(int megabytes)
+{
+	loadSpritesOnDemand = true;
+	spriteQueue.SetBudget(static_cast<size_t>(max(0, megabytes)) << 20);
+}
+
+
+
 void GameData::FinishLoading()
 {
 	// Store the current state, to revert back to later.
@@ -188,6 +220,7 @@ void GameData::FinishLoading()
 	playerGovernment = objects.governments.Get("Escort");
 
 	politics.Reset();
+	DistanceMap::ClearCache();
 }
 
 
@@ -245,8 +278,30 @@ bool GameData::IsLoaded()
 
 
 
-// Begin loading a sprite that was previously deferred. Currently this is
-// done with all landscapes to speed up the program's startup.
+// Get the fraction of the game data, and of the sprites needed to show the
+// main menu, that have been loaded. Other sprites may still be loading.
+double GameData::GetMenuProgress()
+{
+	return min(spriteQueue.GetUrgentProgress(), objects.GetProgress());
+}
+
+
+
+// If the given sprite has not started loading yet, load it before any
+// sprites that are not needed for the main menu.
+void GameData::Prioritize(const Sprite *sprite)
+{
+	if(sprite)
+		spriteQueue.Prioritize(sprite->Name());
+}
+
+
+
+// Begin loading a sprite that was previously deferred. This is done with
+// all landscapes to speed up the program's startup, and with most other
+// sprites if they are loaded on demand. This is called from both the main
+// thread and the engine's thread, which preloads the landscapes of each
+// system that the player enters.
 void GameData::Preload(const Sprite *sprite)
 {
 	// Make sure this sprite actually is one that uses deferred loading.
@@ -254,6 +309,22 @@ void GameData::Preload(const Sprite *sprite)
 	if(!sprite || dit == deferred.end())
 		return;
 
+	// Sprites that are loaded on demand only ask to be loaded when they are
+	// drawn and are not loaded yet, and the sprite queue takes care of
+	// unloading them again.
+	if(sprite->IsLoadedOnDemand())
+	{
+		spriteQueue.Add(dit->second);
+		return;
+	}
+
+	// The list of deferred sprites does not change once the game is loaded, and
+	// the sprite queue has its own locks, but the list of preloaded sprites
+	// must only be changed by one thread at a time.
+#ifndef ES_NO_THREADS
+	lock_guard<mutex> lock(preloadMutex);
+#endif // ES_NO_THREADS
+
 	// If this sprite is one of the currently loaded ones, there is no need to
 	// load it again. But, make note of the fact that it is the most recently
 	// asked-for sprite.
@@ -271,14 +342,13 @@ void GameData::Preload(const Sprite *sprite)
 	// This sprite is not currently preloaded. Check to see whether we already
 	// have the maximum number of sprites loaded, in which case the oldest one
 	// must be unloaded to make room for this one.
-	const string &name = sprite->Name();
 	pit = preloaded.begin();
 	while(pit != preloaded.end())
 	{
 		++pit->second;
 		if(pit->second >= 20)
 		{
-			spriteQueue.Unload(name);
+			spriteQueue.Unload(pit->first->Name());
 			pit = preloaded.erase(pit);
 		}
 		else
@@ -340,6 +410,7 @@ void GameData::Revert()
 
 	politics.Reset();
 	purchases.clear();
+	DistanceMap::ClearCache();
 }
 
 
@@ -482,6 +553,7 @@ void GameData::AddPurchase(const System &system, const string &commodity, int to
 void GameData::Change(const DataNode &node)
 {
 	objects.Change(node);
+	DistanceMap::ClearCache();
 }
 
 
@@ -491,6 +563,7 @@ void GameData::Change(const DataNode &node)
 void GameData::UpdateSystems()
 {
 	objects.UpdateSystems();
+	DistanceMap::ClearCache();
 }
 
 
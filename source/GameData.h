@@ -75,11 +75,18 @@ class Wormhole;
 // universe.
 class GameData {
 public:
+	// Begin loading the game data. If preventUpload is set, images are still
+	// loaded (so sprites have sizes and collision masks) but no textures are
+	// created, which allows running without an OpenGL context.
 #ifndef ES_NO_THREADS
-	static std::future<void> BeginLoad(bool onlyLoadData, bool debugMode);
+	static std::future<void> BeginLoad(bool onlyLoadData, bool debugMode, bool preventUpload);
 #else
-	static void BeginLoad(bool onlyLoadData, bool debugMode);
+	static void BeginLoad(bool onlyLoadData, bool debugMode, bool preventUpload);
 #endif // ES_NO_THREADS
+	// Only load sprites once they are first drawn, and unload the ones that
+	// have not been drawn for a while once they use more than the given number
+	// of megabytes of texture memory. This must be called before BeginLoad().
+	static void LoadSpritesOnDemand(int megabytes);
 	static void FinishLoading();
 	// Check for objects that are referred to but never defined.
 	static void CheckReferences();
@@ -87,8 +94,17 @@ public:
 	static double GetProgress();
 	// Whether initial game loading is complete (data, sprites and audio are loaded).
 	static bool IsLoaded();
-	// Begin loading a sprite that was previously deferred. Currently this is
-	// done with all landscapes to speed up the program's startup.
+	// Get the fraction of the game data, and of the sprites needed to show the
+	// main menu, that have been loaded. Other sprites may still be loading.
+	static double GetMenuProgress();
+	// If the given sprite has not started loading yet, load it before any
+	// sprites that are not needed for the main menu.
+	static void Prioritize(const Sprite *sprite);
+	// Begin loading a sprite that was previously deferred. This is done with
+	// all landscapes to speed up the program's startup, and with most other
+	// sprites if they are loaded on demand. This is called from both the main
+	// thread and the engine's thread, which preloads the landscapes of each
+	// system that the player enters.
 	static void Preload(const Sprite *sprite);
 	static void ProcessSprites();
 	// Wait until all pending sprite uploads are completed.
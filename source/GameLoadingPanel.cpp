@@ -31,17 +31,22 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Ship.h"
 #include "SpriteSet.h"
 #include "StarField.h"
+#include "StellarObject.h"
 #include "System.h"
 #include "UI.h"
 
 #include "opengl.h"
 
+#include <memory>
+
+using namespace std;
+
 
 
 GameLoadingPanel::GameLoadingPanel(PlayerInfo &player, const Conversation &conversation,
-	UI &gamePanels, bool &finishedLoading)
+	UI &gamePanels, bool &finishedLoading, bool showMenuEarly)
 	: player(player), conversation(conversation), gamePanels(gamePanels),
-		finishedLoading(finishedLoading), ANGLE_OFFSET(360. / MAX_TICKS)
+		finishedLoading(finishedLoading), showMenuEarly(showMenuEarly), ANGLE_OFFSET(360. / MAX_TICKS)
 {
 	SetIsFullScreen(true);
 }
@@ -54,7 +59,8 @@ void GameLoadingPanel::Step()
 
 	// While the game is loading, upload sprites to the GPU.
 	GameData::ProcessSprites();
-	if(GameData::IsLoaded())
+	bool isLoaded = GameData::IsLoaded();
+	if(isLoaded)
 	{
 		// Now that we have finished loading all the basic sprites and sounds, we can look for invalid file paths,
 		// e.g. due to capitalization errors or other typos.
@@ -63,30 +69,17 @@ void GameLoadingPanel::Step()
 		// All sprites with collision masks should also have their 1x scaled versions, so create
 		// any additional scaled masks from the default one.
 		GameData::GetMaskManager().ScaleMasks();
-		// Set the game's initial internal state.
-		GameData::FinishLoading();
+		GameData::GetMaskManager().CacheBounds();
+		// The main menu's buttons that start the game work from now on, even
+		// if some sprites are unloaded and loaded again later.
+		finishedLoading = true;
+	}
 
-		player.LoadRecent();
+	if(!isMenuShown && (isLoaded || (showMenuEarly && GameData::GetMenuProgress() == 1.)))
+		ShowMenu();
 
+	if(isLoaded)
 		GetUI()->Pop(this);
-		if(conversation.IsEmpty())
-		{
-			GetUI()->Push(new MenuPanel(player, gamePanels));
-			GetUI()->Push(new MenuAnimationPanel());
-		}
-		else
-		{
-			GetUI()->Push(new MenuAnimationPanel());
-
-			auto *talk = new ConversationPanel(player, conversation);
-
-			UI *ui = GetUI();
-			talk->SetCallback([ui](int response) { ui->Quit(); });
-			GetUI()->Push(talk);
-		}
-
-		finishedLoading = true;
-	}
 }
 
 
@@ -109,3 +102,41 @@ void GameLoadingPanel::Draw()
 	}
 	PointerShader::Unbind();
 }
+
+
+
+// Load the player and show the main menu.
+void GameLoadingPanel::ShowMenu()
+{
+	// Set the game's initial internal state.
+	GameData::FinishLoading();
+
+	player.LoadRecent();
+	// The player's ships and the system that they are in will be the first
+	// things drawn once the game starts, so load them before other sprites.
+	for(const shared_ptr<Ship> &ship : player.Ships())
+	{
+		GameData::Prioritize(ship->GetSprite());
+		GameData::Prioritize(ship->Thumbnail());
+	}
+	if(player.GetSystem())
+		for(const StellarObject &object : player.GetSystem()->Objects())
+			GameData::Prioritize(object.GetSprite());
+
+	isMenuShown = true;
+	if(conversation.IsEmpty())
+	{
+		GetUI()->Push(new MenuPanel(player, gamePanels, finishedLoading));
+		GetUI()->Push(new MenuAnimationPanel());
+	}
+	else
+	{
+		GetUI()->Push(new MenuAnimationPanel());
+
+		auto *talk = new ConversationPanel(player, conversation);
+
+		UI *ui = GetUI();
+		talk->SetCallback([ui](int response) { ui->Quit(); });
+		GetUI()->Push(talk);
+	}
+}
@@ -28,20 +28,30 @@ class UI;
 
 
 // Class representing the loading menu, which is shown when loading resources
-// (like game data and save files).
+// (like game data and save files). If the main menu is shown early, it is shown
+// as soon as the data and the sprites it needs are loaded, and this panel stays
+// below it until all the other sprites are loaded, too.
 class GameLoadingPanel final : public Panel {
 public:
-	GameLoadingPanel(PlayerInfo &player, const Conversation &conversation, UI &gamePanels, bool &finishedLoading);
+	GameLoadingPanel(PlayerInfo &player, const Conversation &conversation, UI &gamePanels, bool &finishedLoading,
+		bool showMenuEarly = false);
 
 	void Step() final;
 	void Draw() final;
 
 
+private:
+	// Load the player and show the main menu.
+	void ShowMenu();
+
+
 private:
 	PlayerInfo &player;
 	const Conversation &conversation;
 	UI &gamePanels;
 	bool &finishedLoading;
+	const bool showMenuEarly;
+	bool isMenuShown = false;
 
 	// The circular loading indicator shows 60 tick marks when all game data is loaded.
 	const int MAX_TICKS = 60;
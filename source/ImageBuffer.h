@@ -58,6 +58,9 @@ public:
 	// Read a single frame. Return false if an error is encountered - either the
 	// image is the wrong size, or it is not a supported image format.
 	bool Read(const std::string &path, int frame = 0);
+	// Read only the dimensions of the image at the given path, without decoding
+	// its pixels. Return false if it is not a supported image format.
+	static bool ReadSize(const std::string &path, int &width, int &height);
 
 
 private:
@@ -0,0 +1,131 @@
+/* ImageCache.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ImageCache.h"
+
+#include "File.h"
+#include "Files.h"
+#include "ImageBuffer.h"
+
+#include <cstdint>
+#include <cstdio>
+
+using namespace std;
+
+namespace {
+	// Every cached image starts with this, followed by the version of the format.
+	// Change the version whenever the format changes, so that old files are ignored.
+	const string MAGIC = "ESIC";
+	const uint32_t VERSION = 1;
+
+	// The directory that cached images are kept in. If this is empty, the cache
+	// is turned off. It is only set before any images are loaded.
+	string cacheDirectory;
+
+	// Get the path of the cached copy of the given image.
+	string CachePath(const string &path)
+	{
+		return Files::CachePath(cacheDirectory, path, ".rgba");
+	}
+
+	// Read an integer that was written by Files::WriteInt().
+	bool ReadInt(FILE *in, uint64_t &value, int bytes)
+	{
+		unsigned char data[8];
+		if(fread(data, 1, bytes, in) != static_cast<size_t>(bytes))
+			return false;
+
+		value = 0;
+		for(int i = 0; i < bytes; ++i)
+			value |= static_cast<uint64_t>(data[i]) << (8 * i);
+		return true;
+	}
+}
+
+
+
+// Store cached images in the given directory, creating it if necessary.
+void ImageCache::Init(const string &directory)
+{
+	cacheDirectory = directory;
+	if(!cacheDirectory.empty() && cacheDirectory.back() != '/')
+		cacheDirectory += '/';
+	Files::CreateFolder(cacheDirectory);
+	if(!Files::Exists(cacheDirectory))
+		cacheDirectory.clear();
+}
+
+
+
+// Check whether the cache is turned on.
+bool ImageCache::IsEnabled()
+{
+	return !cacheDirectory.empty();
+}
+
+
+
+// If there is an up to date copy of the given image in the cache, read it
+// into the given frame of the buffer and return true. If the buffer has not
+// been allocated yet, it is allocated to the size of the image.
+bool ImageCache::Read(const string &path, ImageBuffer &buffer, int frame)
+{
+	if(cacheDirectory.empty() || frame < 0 || frame >= buffer.Frames())
+		return false;
+
+	File file(CachePath(path));
+	if(!file)
+		return false;
+
+	// Check the header before reading anything else.
+	string header = Files::CacheHeader(MAGIC, VERSION, path);
+	string stored(header.size(), '\0');
+	if(fread(&stored[0], 1, stored.size(), file) != stored.size() || stored != header)
+		return false;
+
+	uint64_t width = 0;
+	uint64_t height = 0;
+	if(!ReadInt(file, width, 4) || !ReadInt(file, height, 4) || !width || !height)
+		return false;
+
+	// Every frame of an image set must be the same size. If this one is not,
+	// let the caller decode the image so that it reports the error.
+	buffer.Allocate(width, height);
+	if(static_cast<uint64_t>(buffer.Width()) != width || static_cast<uint64_t>(buffer.Height()) != height)
+		return false;
+
+	// The pixels are read straight into the buffer. If the file is cut short,
+	// the caller decodes the image again, overwriting whatever was read.
+	size_t pixels = width * height;
+	return fread(buffer.Begin(0, frame), sizeof(uint32_t), pixels, file) == pixels && fgetc(file) == EOF;
+}
+
+
+
+// Save the given frame of the buffer as the decoded form of the given image.
+void ImageCache::Write(const string &path, const ImageBuffer &buffer, int frame)
+{
+	if(cacheDirectory.empty() || !buffer.Pixels() || frame < 0 || frame >= buffer.Frames())
+		return;
+
+	// The pixels are stored in the byte order that OpenGL expects, so they do
+	// not depend on the machine that wrote them.
+	string out = Files::CacheHeader(MAGIC, VERSION, path);
+	Files::WriteInt(out, buffer.Width(), 4);
+	Files::WriteInt(out, buffer.Height(), 4);
+	const char *begin = reinterpret_cast<const char *>(buffer.Begin(0, frame));
+	out.append(begin, sizeof(uint32_t) * buffer.Width() * buffer.Height());
+	Files::WriteBinary(CachePath(path), out);
+}
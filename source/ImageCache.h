@@ -0,0 +1,49 @@
+/* ImageCache.h
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IMAGE_CACHE_H_
+#define IMAGE_CACHE_H_
+
+#include <string>
+
+class ImageBuffer;
+
+
+
+// This class is a collection of global functions for keeping a copy of each
+// decoded image on disk, with its colors already converted to premultiplied
+// alpha or additive blending, so that an image that has not changed since it
+// was last read can be copied straight into an ImageBuffer instead of being
+// decoded again. Like DataFileCache, each copy remembers the path, size, and
+// modification time of the image that it was made from. The cache is off until
+// it is given a directory to use.
+class ImageCache {
+public:
+	// Store cached images in the given directory, creating it if necessary.
+	static void Init(const std::string &directory);
+	// Check whether the cache is turned on.
+	static bool IsEnabled();
+
+	// If there is an up to date copy of the given image in the cache, read it
+	// into the given frame of the buffer and return true. If the buffer has not
+	// been allocated yet, it is allocated to the size of the image.
+	static bool Read(const std::string &path, ImageBuffer &buffer, int frame);
+	// Save the given frame of the buffer as the decoded form of the given image.
+	static void Write(const std::string &path, const ImageBuffer &buffer, int frame);
+};
+
+
+
+#endif
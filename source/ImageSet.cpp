@@ -282,12 +282,38 @@ void ImageSet::Load() noexcept(false)
 
 // Create the sprite and upload the image data to the GPU. After this is
 // called, the internal image buffers and mask vector will be cleared, but
-// the paths are saved in case the sprite needs to be loaded again.
-void ImageSet::Upload(Sprite *sprite)
+// the paths are saved in case the sprite needs to be loaded again. If
+// uploading is disabled, the sprite and its masks are set up without any
+// textures being created.
+void ImageSet::Upload(Sprite *sprite, bool enableUpload)
 {
 	// Load the frames (this will clear the buffers).
-	sprite->AddFrames(buffer[0], false);
-	sprite->AddFrames(buffer[1], true);
+	sprite->AddFrames(buffer[0], false, enableUpload);
+	sprite->AddFrames(buffer[1], true, enableUpload);
 	GameData::GetMaskManager().SetMasks(sprite, std::move(masks));
 	masks.clear();
 }
+
+
+
+// Give the sprite its dimensions without reading any of the images, so
+// that they can be loaded once the sprite is first drawn. Sprites that
+// need collision masks cannot wait that long. Return false if the sprite
+// must be loaded right away instead.
+bool ImageSet::LoadOnDemand(Sprite *sprite) const
+{
+	assert(framePaths[0].empty() && "should call ValidateFrames before calling LoadOnDemand");
+
+	if(IsMasked(name) || paths[0].empty())
+		return false;
+
+	// Only the first frame is checked. If any other frame has a different
+	// size, that will be reported once the sprite is loaded.
+	int width = 0;
+	int height = 0;
+	if(!ImageBuffer::ReadSize(paths[0][0], width, height))
+		return false;
+
+	sprite->LoadOnDemand(width, height, paths[0].size());
+	return true;
+}
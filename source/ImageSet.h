@@ -62,8 +62,15 @@ public:
 	void Load() noexcept(false);
 	// Create the sprite and upload the image data to the GPU. After this is
 	// called, the internal image buffers and mask vector will be cleared, but
-	// the paths are saved in case the sprite needs to be loaded again.
-	void Upload(Sprite *sprite);
+	// the paths are saved in case the sprite needs to be loaded again. If
+	// uploading is disabled, the sprite and its masks are set up without any
+	// textures being created.
+	void Upload(Sprite *sprite, bool enableUpload);
+	// Give the sprite its dimensions without reading any of the images, so
+	// that they can be loaded once the sprite is first drawn. Sprites that
+	// need collision masks cannot wait that long. Return false if the sprite
+	// must be loaded right away instead.
+	bool LoadOnDemand(Sprite *sprite) const;
 
 
 private:
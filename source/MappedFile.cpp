@@ -0,0 +1,88 @@
+/* MappedFile.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "MappedFile.h"
+
+#include "Files.h"
+
+#if !defined _WIN32 && !defined __EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+
+MappedFile::MappedFile(const string &path)
+{
+#if !defined _WIN32 && !defined __EMSCRIPTEN__
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd >= 0)
+	{
+		// Empty files cannot be mapped, but they do not need to be.
+		bool isEmpty = false;
+		struct stat buf;
+		if(!fstat(fd, &buf) && S_ISREG(buf.st_mode))
+		{
+			isEmpty = !buf.st_size;
+			void *mapping = isEmpty ? MAP_FAILED : mmap(nullptr, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(mapping != MAP_FAILED)
+			{
+				data = static_cast<const char *>(mapping);
+				size = buf.st_size;
+				isMapped = true;
+			}
+		}
+		// The mapping stays valid after the file is closed.
+		close(fd);
+		if(isMapped || isEmpty)
+			return;
+	}
+#endif
+
+	// If the file could not be mapped, fall back to reading all of it.
+	contents = Files::Read(path);
+	data = contents.data();
+	size = contents.size();
+}
+
+
+
+MappedFile::~MappedFile() noexcept
+{
+#if !defined _WIN32 && !defined __EMSCRIPTEN__
+	if(isMapped)
+		munmap(const_cast<char *>(data), size);
+#endif
+}
+
+
+
+// Get the contents of the file. If the file is empty or could not be read,
+// the size is zero.
+const char *MappedFile::Data() const noexcept
+{
+	return data;
+}
+
+
+
+size_t MappedFile::Size() const noexcept
+{
+	return size;
+}
@@ -0,0 +1,54 @@
+/* MappedFile.h
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ES_MAPPED_FILE_H_
+#define ES_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+
+
+// Read-only view of the entire contents of a file. Where the operating system
+// supports it, the file is mapped into memory rather than copied, so that its
+// contents are only paged in as they are read. Otherwise, it is read into
+// memory with Files::Read(). The contents are not followed by a null character.
+class MappedFile {
+public:
+	explicit MappedFile(const std::string &path);
+	MappedFile(const MappedFile &) = delete;
+	~MappedFile() noexcept;
+
+	// Do not allow copying the mapping.
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	// Get the contents of the file. If the file is empty or could not be read,
+	// the size is zero.
+	const char *Data() const noexcept;
+	std::size_t Size() const noexcept;
+
+
+private:
+	const char *data = nullptr;
+	std::size_t size = 0;
+	// Whether the data must be unmapped when this object is destroyed.
+	bool isMapped = false;
+	// If the file could not be mapped, its contents are copied into here.
+	std::string contents;
+};
+
+
+
+#endif
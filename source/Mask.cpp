@@ -17,14 +17,59 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "ImageBuffer.h"
 #include "Logger.h"
+#include "pi.h"
 
 #include <algorithm>
 #include <cmath>
 #include <limits>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 
 namespace {
+	// Bounding boxes are made this much larger than they need to be, so that
+	// rounding errors never make a collision be missed.
+	const double BOUNDS_MARGIN = 1.;
+
+	// Check whether the segment from a to a + v touches the given box.
+	bool SegmentTouchesBox(const Point &a, const Point &v, const double *box)
+	{
+		double first = 0.;
+		double last = 1.;
+		for(int axis = 0; axis < 2; ++axis)
+		{
+			const double start = axis ? a.Y() : a.X();
+			const double length = axis ? v.Y() : v.X();
+			const double low = box[axis];
+			const double high = box[axis + 2];
+			if(!length)
+			{
+				if(start < low || start > high)
+					return false;
+				continue;
+			}
+			double enter = (low - start) / length;
+			double exit = (high - start) / length;
+			if(enter > exit)
+				swap(enter, exit);
+			first = max(first, enter);
+			last = min(last, exit);
+			if(first > last)
+				return false;
+		}
+		return true;
+	}
+
+	// The number of edges that Intersection() checks at once.
+#ifdef __SSE2__
+	const size_t EDGE_BLOCK = 2;
+#else
+	const size_t EDGE_BLOCK = 1;
+#endif
+
 	// Trace out outlines from an image frame.
 	void Trace(const ImageBuffer &image, int frame, vector<vector<Point>> &raw)
 	{
@@ -306,6 +351,8 @@ void Mask::Create(const ImageBuffer &image, int frame)
 		outlines.back().shrink_to_fit();
 	}
 	outlines.shrink_to_fit();
+	PackEdges();
+	CacheBounds(0);
 }
 
 
@@ -334,6 +381,11 @@ double Mask::Collide(Point sA, Point vA, Angle facing) const
 	if(DistanceSquared(Point(), sA, sA + vA) > (radius * radius))
 		return 1.;
 
+	// Or, if it doesn't touch the box around the mask at this facing.
+	const double *box = Bounds(facing);
+	if(box && !SegmentTouchesBox(sA, vA, box))
+		return 1.;
+
 	// Rotate into the mask's frame of reference.
 	sA = (-facing).Rotate(sA);
 	vA = (-facing).Rotate(vA);
@@ -359,6 +411,10 @@ bool Mask::Contains(Point point, Angle facing) const
 	if(!IsLoaded() || point.Length() > radius)
 		return false;
 
+	const double *box = Bounds(facing);
+	if(box && (point.X() < box[0] || point.Y() < box[1] || point.X() > box[2] || point.Y() > box[3]))
+		return false;
+
 	// Rotate into the mask's frame of reference.
 	return Contains((-facing).Rotate(point));
 }
@@ -373,12 +429,26 @@ bool Mask::WithinRing(Point point, Angle facing, double inner, double outer) con
 	if(!IsLoaded() || inner > point.Length() + radius || outer < point.Length() - radius)
 		return false;
 
-	// Rotate into the mask's frame of reference.
-	point = (-facing).Rotate(point);
 	// For efficiency, compare to range^2 instead of range.
 	inner *= inner;
 	outer *= outer;
 
+	// Every point of the outline is within the box around the mask, so if the
+	// whole box is inside the ring's hole or outside the ring, so is the mask.
+	const double *box = Bounds(facing);
+	if(box)
+	{
+		const double nearX = max(0., max(box[0] - point.X(), point.X() - box[2]));
+		const double nearY = max(0., max(box[1] - point.Y(), point.Y() - box[3]));
+		const double farX = max(fabs(box[0] - point.X()), fabs(box[2] - point.X()));
+		const double farY = max(fabs(box[1] - point.Y()), fabs(box[3] - point.Y()));
+		if(nearX * nearX + nearY * nearY >= outer || farX * farX + farY * farY <= inner)
+			return false;
+	}
+
+	// Rotate into the mask's frame of reference.
+	point = (-facing).Rotate(point);
+
 	for(auto &&outline : outlines)
 		for(auto &&p : outline)
 		{
@@ -435,6 +505,9 @@ Mask Mask::operator*(double scale) const
 		for(Point &p : outline)
 			p *= scale;
 	newMask.radius *= scale;
+	newMask.PackEdges();
+	// The boxes are not scaled, because they include a fixed margin.
+	newMask.CacheBounds(0);
 	return newMask;
 }
 
@@ -449,35 +522,54 @@ Mask operator*(double scale, const Mask &mask)
 
 double Mask::Intersection(Point sA, Point vA) const
 {
-	// Keep track of the closest intersection point found.
+	// Check if there is an intersection with each edge. (If not, the cross
+	// would be 0.) If there is, handle it only if it is a point where the
+	// segment is entering the polygon rather than exiting it (i.e. cross > 0).
+	// Then, if the intersection occurs somewhere within that edge, find out
+	// how far along the query vector it occurs, and keep the closest one.
+	const size_t count = edgeX.size();
+#ifdef __SSE2__
+	const __m128d zero = _mm_setzero_pd();
+	const __m128d one = _mm_set1_pd(1.);
+	const __m128d sX = _mm_set1_pd(sA.X());
+	const __m128d sY = _mm_set1_pd(sA.Y());
+	const __m128d aX = _mm_set1_pd(vA.X());
+	const __m128d aY = _mm_set1_pd(vA.Y());
+	__m128d closest = one;
+	for(size_t i = 0; i < count; i += EDGE_BLOCK)
+	{
+		const __m128d bX = _mm_loadu_pd(&edgeDX[i]);
+		const __m128d bY = _mm_loadu_pd(&edgeDY[i]);
+		const __m128d cross = _mm_sub_pd(_mm_mul_pd(bX, aY), _mm_mul_pd(bY, aX));
+		const __m128d vSX = _mm_sub_pd(_mm_loadu_pd(&edgeX[i]), sX);
+		const __m128d vSY = _mm_sub_pd(_mm_loadu_pd(&edgeY[i]), sY);
+		const __m128d uB = _mm_sub_pd(_mm_mul_pd(aX, vSY), _mm_mul_pd(aY, vSX));
+		const __m128d uA = _mm_sub_pd(_mm_mul_pd(bX, vSY), _mm_mul_pd(bY, vSX));
+		const __m128d hit = _mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(cross, zero), _mm_cmpge_pd(uA, zero)),
+			_mm_and_pd(_mm_cmpge_pd(uB, zero), _mm_cmplt_pd(uB, cross)));
+		// The division is done for every edge, but only the results for the
+		// edges that are actually hit are kept.
+		const __m128d range = _mm_or_pd(_mm_and_pd(hit, _mm_div_pd(uA, cross)), _mm_andnot_pd(hit, one));
+		closest = _mm_min_pd(closest, range);
+	}
+	return min(_mm_cvtsd_f64(closest), _mm_cvtsd_f64(_mm_unpackhi_pd(closest, closest)));
+#else
 	double closest = 1.;
-
-	for(auto &&outline : outlines)
+	for(size_t i = 0; i < count; ++i)
 	{
-		Point prev = outline.back();
-		for(auto &&next : outline)
+		const double cross = edgeDX[i] * vA.Y() - edgeDY[i] * vA.X();
+		if(cross > 0.)
 		{
-			// Check if there is an intersection. (If not, the cross would be 0.) If
-			// there is, handle it only if it is a point where the segment is
-			// entering the polygon rather than exiting it (i.e. cross > 0).
-			Point vB = next - prev;
-			double cross = vB.Cross(vA);
-			if(cross > 0.)
-			{
-				Point vS = prev - sA;
-				double uB = vA.Cross(vS);
-				double uA = vB.Cross(vS);
-				// If the intersection occurs somewhere within this segment of the
-				// outline, find out how far along the query vector it occurs and
-				// remember it if it is the closest so far.
-				if((uB >= 0.) & (uB < cross) & (uA >= 0.))
-					closest = min(closest, uA / cross);
-			}
-
-			prev = next;
+			const double vSX = edgeX[i] - sA.X();
+			const double vSY = edgeY[i] - sA.Y();
+			const double uB = vA.X() * vSY - vA.Y() * vSX;
+			const double uA = edgeDX[i] * vSY - edgeDY[i] * vSX;
+			if((uB >= 0.) & (uB < cross) & (uA >= 0.))
+				closest = min(closest, uA / cross);
 		}
 	}
 	return closest;
+#endif
 }
 
 
@@ -515,3 +607,79 @@ bool Mask::Contains(Point point) const
 	// If the number of intersections is odd, the point is within the mask.
 	return (intersections & 1);
 }
+
+
+
+// Split the full circle into the given number of equal ranges of facing
+// angles, and find the box that holds this mask at every facing in each range.
+void Mask::CacheBounds(unsigned buckets)
+{
+	bounds.clear();
+	this->buckets = IsLoaded() ? buckets : 0;
+	if(!this->buckets)
+		return;
+
+	// Turning by up to half of a range, plus one step of rounding in the
+	// Angle of its center, moves any point by no more than this much.
+	const double halfRange = 180. / buckets + 360. / 65536.;
+	const double drift = 2. * radius * sin(.5 * halfRange * TO_RAD) + BOUNDS_MARGIN;
+
+	bounds.reserve(4 * buckets);
+	for(unsigned i = 0; i < buckets; ++i)
+	{
+		const Angle center((i + .5) * 360. / buckets);
+		Point low(numeric_limits<double>::infinity(), numeric_limits<double>::infinity());
+		Point high = -low;
+		for(auto &&outline : outlines)
+			for(auto &&p : outline)
+			{
+				Point rotated = center.Rotate(p);
+				low = min(low, rotated);
+				high = max(high, rotated);
+			}
+		bounds.push_back(low.X() - drift);
+		bounds.push_back(low.Y() - drift);
+		bounds.push_back(high.X() + drift);
+		bounds.push_back(high.Y() + drift);
+	}
+}
+
+
+
+// Copy the edges of the outlines into the packed arrays.
+void Mask::PackEdges()
+{
+	edgeX.clear();
+	edgeY.clear();
+	edgeDX.clear();
+	edgeDY.clear();
+	for(auto &&outline : outlines)
+	{
+		Point prev = outline.back();
+		for(auto &&next : outline)
+		{
+			Point vB = next - prev;
+			edgeX.push_back(prev.X());
+			edgeY.push_back(prev.Y());
+			edgeDX.push_back(vB.X());
+			edgeDY.push_back(vB.Y());
+			prev = next;
+		}
+	}
+	// An edge with no length can never be hit, so use those as padding.
+	while(edgeX.size() % EDGE_BLOCK)
+	{
+		edgeX.push_back(0.);
+		edgeY.push_back(0.);
+		edgeDX.push_back(0.);
+		edgeDY.push_back(0.);
+	}
+}
+
+
+
+// Get the bounding box for the given facing, or null if none are cached.
+const double *Mask::Bounds(Angle facing) const
+{
+	return buckets ? &bounds[4 * facing.Bucket(buckets)] : nullptr;
+}
@@ -61,6 +61,13 @@ public:
 	// Get the individual outlines that comprise this mask.
 	const std::vector<std::vector<Point>> &Outlines() const;
 
+	// Split the full circle into the given number of equal ranges of facing
+	// angles (a power of two, no more than 65536), and find the box that holds
+	// this mask at every facing in each range. Queries then check that box
+	// before rotating into the mask's frame and testing the outlines. Zero
+	// ranges means no boxes are kept.
+	void CacheBounds(unsigned buckets);
+
 	// Scale all the points in the mask.
 	Mask operator*(double scale) const;
 	friend Mask operator*(double scale, const Mask &mask);
@@ -69,11 +76,28 @@ public:
 private:
 	double Intersection(Point sA, Point vA) const;
 	bool Contains(Point point) const;
+	// Copy the edges of the outlines into the packed arrays below.
+	void PackEdges();
+	// Get the bounding box for the given facing, as the minimum and maximum x
+	// and y coordinates, or null if no boxes have been cached.
+	const double *Bounds(Angle facing) const;
 
 
 private:
 	std::vector<std::vector<Point>> outlines;
 	double radius = 0.;
+
+	// The start point and the direction of every edge of every outline, stored
+	// in separate arrays so that Intersection() can test several edges at once.
+	// The arrays are padded with empty edges to a multiple of the vector width.
+	std::vector<double> edgeX;
+	std::vector<double> edgeY;
+	std::vector<double> edgeDX;
+	std::vector<double> edgeDY;
+
+	// The cached bounding boxes, four values for each range of facings.
+	std::vector<double> bounds;
+	unsigned buckets = 0;
 };
 
 
@@ -22,7 +22,15 @@ using namespace std;
 
 namespace {
 	constexpr double DEFAULT = 1.;
+	// Masks may be looked up from several threads at once, e.g. by the AI.
 	map<const Sprite *, bool> warned;
+	mutex warnedMutex;
+
+	bool ShouldWarn(const Sprite *sprite)
+	{
+		lock_guard<mutex> lock(warnedMutex);
+		return warned.insert(make_pair(sprite, true)).second;
+	}
 
 	string PrintScale(double s)
 	{
@@ -91,6 +99,19 @@ void MaskManager::ScaleMasks()
 
 
 
+// Optionally, have every mask at every scale precompute its bounding box
+// for each of the given number of ranges of facing angles. This must be
+// done after the masks are scaled.
+void MaskManager::CacheBounds(unsigned angleBuckets)
+{
+	for(auto &spriteScales : spriteMasks)
+		for(auto &scale : spriteScales.second)
+			for(Mask &mask : scale.second)
+				mask.CacheBounds(angleBuckets);
+}
+
+
+
 // Get the masks for the given sprite at the given scale. If a
 // sprite has no masks, an empty mask is returned.
 const std::vector<Mask> &MaskManager::GetMasks(const Sprite *sprite, double scale) const
@@ -99,7 +120,7 @@ const std::vector<Mask> &MaskManager::GetMasks(const Sprite *sprite, double scal
 	const auto scalesIt = spriteMasks.find(sprite);
 	if(scalesIt == spriteMasks.end())
 	{
-		if(warned.insert(make_pair(sprite, true)).second)
+		if(ShouldWarn(sprite))
 			Logger::LogError("Warning: sprite \"" + sprite->Name() + "\": no collision masks found.");
 		return EMPTY;
 	}
@@ -110,7 +131,7 @@ const std::vector<Mask> &MaskManager::GetMasks(const Sprite *sprite, double scal
 		return maskIt->second;
 
 	// Shouldn't happen, but just in case, print some details about the scales for this sprite (once).
-	if(warned.insert(make_pair(sprite, true)).second)
+	if(ShouldWarn(sprite))
 	{
 		string warning = "Warning: sprite \"" + sprite->Name() + "\": collision mask not found.";
 		if(scales.empty()) warning += " (No scaled masks.)";
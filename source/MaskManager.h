@@ -39,6 +39,10 @@ public:
 
 	// Create the scaled versions of all masks from the 1x versions.
 	void ScaleMasks();
+	// Optionally, have every mask at every scale precompute its bounding box
+	// for each of the given number of ranges of facing angles. This must be
+	// done after the masks are scaled.
+	void CacheBounds(unsigned angleBuckets = 64);
 
 	// Get the masks for the given sprite at the given scale. If a
 	// sprite has no masks, an empty mask is returned.
@@ -55,10 +55,11 @@ namespace {
 
 
 
-MenuPanel::MenuPanel(PlayerInfo &player, UI &gamePanels)
-	: player(player), gamePanels(gamePanels), mainMenuUi(GameData::Interfaces().Get("main menu"))
+MenuPanel::MenuPanel(PlayerInfo &player, UI &gamePanels, const bool &finishedLoading)
+	: player(player), gamePanels(gamePanels), finishedLoading(finishedLoading),
+		mainMenuUi(GameData::Interfaces().Get("main menu"))
 {
-	assert(GameData::IsLoaded() && "MenuPanel should only be created after all data is fully loaded");
+	assert(GameData::GetMenuProgress() == 1. && "MenuPanel should only be created after all data is fully loaded");
 	SetIsFullScreen(true);
 
 	if(mainMenuUi->GetBox("credits").Dimensions())
@@ -81,14 +82,8 @@ MenuPanel::MenuPanel(PlayerInfo &player, UI &gamePanels)
 		showCreditsWarning = false;
 	}
 
-	if(gamePanels.IsEmpty())
-	{
-		gamePanels.Push(new MainPanel(player));
-		// It takes one step to figure out the planet panel should be created, and
-		// another step to actually place it. So, take two steps to avoid a flicker.
-		gamePanels.StepAll();
-		gamePanels.StepAll();
-	}
+	needsMainPanel = gamePanels.IsEmpty();
+	CreateMainPanel();
 
 	if(player.GetPlanet())
 		Audio::PlayMusic(player.GetPlanet()->MusicName());
@@ -98,6 +93,10 @@ MenuPanel::MenuPanel(PlayerInfo &player, UI &gamePanels)
 
 void MenuPanel::Step()
 {
+	// If the main menu was shown while sprites were still loading, the main
+	// panel is created once they are done.
+	CreateMainPanel();
+
 	if(GetUI()->IsTop(this) && !scrollingPaused)
 	{
 		scroll += scrollSpeed;
@@ -146,6 +145,13 @@ void MenuPanel::Draw()
 		info.SetString("pilot", "No Pilot Loaded");
 	}
 
+	// The buttons that start the game only work once everything is loaded.
+	if(!finishedLoading)
+	{
+		info.SetCondition("loading");
+		info.SetBar("loading", GameData::GetProgress());
+	}
+
 	GameData::Interfaces().Get("menu background")->Draw(info, this);
 	mainMenuUi->Draw(info, this);
 	GameData::Interfaces().Get("menu player info")->Draw(info, this);
@@ -158,21 +164,33 @@ void MenuPanel::Draw()
 
 bool MenuPanel::KeyDown(SDL_Keycode key, Uint16 mod, const Command &command, bool isNewPress)
 {
+	// The game cannot start until all sprites are loaded, because until then
+	// some sprites do not even have a size or a collision mask. This only
+	// applies while the game is starting: later on, sprites may be loaded or
+	// unloaded as they are needed, but they always have their sizes and masks.
+	bool isLoaded = finishedLoading;
 	if(player.IsLoaded() && (key == 'e' || command.Has(Command::MENU)))
 	{
-		gamePanels.CanSave(true);
-		GetUI()->PopThrough(this);
+		if(isLoaded)
+		{
+			gamePanels.CanSave(true);
+			GetUI()->PopThrough(this);
+		}
 	}
 	else if(key == 'p')
 		GetUI()->Push(new PreferencesPanel());
 	else if(key == 'l')
-		GetUI()->Push(new LoadPanel(player, gamePanels));
+	{
+		if(isLoaded)
+			GetUI()->Push(new LoadPanel(player, gamePanels));
+	}
 	else if(key == 'n' && (!player.IsLoaded() || player.IsDead()))
 	{
 		// If no player is loaded, the "Enter Ship" button becomes "New Pilot."
 		// Request that the player chooses a start scenario.
 		// StartConditionsPanel also handles the case where there's no scenarios.
-		GetUI()->Push(new StartConditionsPanel(player, gamePanels, GameData::StartOptions(), nullptr));
+		if(isLoaded)
+			GetUI()->Push(new StartConditionsPanel(player, gamePanels, GameData::StartOptions(), nullptr));
 	}
 	else if(key == 'q')
 		GetUI()->Quit();
@@ -204,6 +222,23 @@ bool MenuPanel::Click(int x, int y, int clicks)
 
 
 
+// Create the panel for flying around, if it does not exist yet. This must
+// wait until the game has finished loading.
+void MenuPanel::CreateMainPanel()
+{
+	if(!needsMainPanel || !finishedLoading)
+		return;
+
+	needsMainPanel = false;
+	gamePanels.Push(new MainPanel(player));
+	// It takes one step to figure out the planet panel should be created, and
+	// another step to actually place it. So, take two steps to avoid a flicker.
+	gamePanels.StepAll();
+	gamePanels.StepAll();
+}
+
+
+
 void MenuPanel::DrawCredits() const
 {
 	const Font &font = FontSet::Get(14);
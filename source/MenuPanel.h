@@ -32,7 +32,9 @@ class UI;
 // credits and basic information on the currently loaded player.
 class MenuPanel : public Panel {
 public:
-	MenuPanel(PlayerInfo &player, UI &gamePanels);
+	// The menu's buttons that start the game only work once the game has
+	// finished loading, as reported by the given flag.
+	MenuPanel(PlayerInfo &player, UI &gamePanels, const bool &finishedLoading);
 
 	virtual void Step() override;
 	virtual void Draw() override;
@@ -45,12 +47,19 @@ protected:
 
 
 private:
+	// Create the panel for flying around, if it does not exist yet. This must
+	// wait until the game has finished loading.
+	void CreateMainPanel();
 	void DrawCredits() const;
 
 
 private:
 	PlayerInfo &player;
 	UI &gamePanels;
+	// Whether everything that is loaded when the game starts has been loaded.
+	const bool &finishedLoading;
+	// Whether the panel for flying around is still to be created.
+	bool needsMainPanel = false;
 
 	const Interface *mainMenuUi;
 
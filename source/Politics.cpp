@@ -15,6 +15,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Politics.h"
 
+#include "DistanceMap.h"
 #include "text/Format.h"
 #include "GameData.h"
 #include "Government.h"
@@ -66,6 +67,8 @@ void Politics::Reset()
 
 	for(const auto &it : GameData::Governments())
 		reputationWith[&it.second] = it.second.InitialPlayerReputation();
+	// Cached distance maps weigh routes by how many enemies are in each system.
+	DistanceMap::ClearCache();
 
 	// Disable fines for today (because the game was just loaded, so any fines
 	// were already checked for when you first landed).
@@ -124,8 +127,9 @@ void Politics::Offend(const Government *gov, int eventType, int count)
 			{
 				// If you bribe a government but then attack it, the effect of
 				// your bribe is canceled out.
-				bribed.erase(other);
-				provoked.insert(other);
+				bool wasBribed = bribed.erase(other);
+				if(provoked.insert(other).second || wasBribed)
+					DistanceMap::ClearCache();
 			}
 		}
 		if(count && abs(weight) >= .05)
@@ -148,8 +152,9 @@ void Politics::Offend(const Government *gov, int eventType, int count)
 // Bribe the given government to be friendly to you for one day.
 void Politics::Bribe(const Government *gov)
 {
-	bribed.insert(gov);
-	provoked.erase(gov);
+	bool wasProvoked = provoked.erase(gov);
+	if(bribed.insert(gov).second || wasProvoked)
+		DistanceMap::ClearCache();
 	fined.insert(gov);
 }
 
@@ -343,7 +348,10 @@ void Politics::SetReputation(const Government *gov, double value)
 {
 	value = min(value, gov->ReputationMax());
 	value = max(value, gov->ReputationMin());
-	reputationWith[gov] = value;
+	double &reputation = reputationWith[gov];
+	if((reputation < 0.) != (value < 0.))
+		DistanceMap::ClearCache();
+	reputation = value;
 }
 
 
@@ -351,6 +359,8 @@ void Politics::SetReputation(const Government *gov, double value)
 // Reset any temporary provocation (typically because a day has passed).
 void Politics::ResetDaily()
 {
+	if(!provoked.empty() || !bribed.empty())
+		DistanceMap::ClearCache();
 	provoked.clear();
 	bribed.clear();
 	bribedPlanets.clear();
@@ -0,0 +1,204 @@
+/* Pool.h
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef POOL_H_
+#define POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#ifndef ES_NO_THREADS
+#include <mutex>
+#endif // ES_NO_THREADS
+
+
+
+// Template for creating shared pointers to objects that are created and
+// destroyed many times while in flight, such as ships, flotsam, and asteroids.
+// Each object is allocated together with its shared_ptr control block, out of
+// blocks of memory that are reused once the object and all weak pointers to it
+// are gone, instead of going through the global allocator every time. As with
+// std::make_shared(), an object never moves once it is created.
+template<class Type>
+class Pool {
+public:
+	// Create an object, passing the given arguments to its constructor.
+	template<class ...Args>
+	static std::shared_ptr<Type> Make(Args &&...args);
+
+
+private:
+	// Memory for objects of a single size, split into chunks. Chunks that are
+	// not in use are kept in a list so they can be handed out again.
+	class Storage {
+	public:
+		explicit Storage(std::size_t size);
+
+		void *Allocate();
+		void Free(void *chunk);
+
+	private:
+		// A chunk that is not in use holds a pointer to the next free one.
+		class Chunk {
+		public:
+			Chunk *next;
+		};
+
+		// Allocate a new block of chunks when all the existing ones are in use.
+		void Grow();
+
+	private:
+		std::size_t size;
+		Chunk *free = nullptr;
+#ifndef ES_NO_THREADS
+		std::mutex freeMutex;
+#endif // ES_NO_THREADS
+	};
+
+	// The allocator given to std::allocate_shared(), which rebinds it to the
+	// type that holds both the object and its control block.
+	template<class T>
+	class Allocator {
+	public:
+		using value_type = T;
+		template<class U>
+		class rebind {
+		public:
+			using other = Allocator<U>;
+		};
+
+		Allocator() = default;
+		template<class U>
+		Allocator(const Allocator<U> &) {}
+
+		T *allocate(std::size_t n);
+		void deallocate(T *p, std::size_t n);
+
+		template<class U>
+		bool operator==(const Allocator<U> &) const { return true; }
+		template<class U>
+		bool operator!=(const Allocator<U> &) const { return false; }
+
+	private:
+		// Chunks may still be freed while the program exits, after static
+		// objects have been destroyed, so the storage is never destroyed.
+		static Storage &GetStorage();
+	};
+};
+
+
+
+// Create an object, passing the given arguments to its constructor.
+template<class Type>
+template<class ...Args>
+std::shared_ptr<Type> Pool<Type>::Make(Args &&...args)
+{
+	return std::allocate_shared<Type>(Allocator<Type>(), std::forward<Args>(args)...);
+}
+
+
+
+template<class Type>
+Pool<Type>::Storage::Storage(std::size_t size)
+	: size(size < sizeof(Chunk) ? sizeof(Chunk) : size)
+{
+}
+
+
+
+template<class Type>
+void *Pool<Type>::Storage::Allocate()
+{
+#ifndef ES_NO_THREADS
+	std::lock_guard<std::mutex> lock(freeMutex);
+#endif // ES_NO_THREADS
+	if(!free)
+		Grow();
+
+	Chunk *chunk = free;
+	free = chunk->next;
+	return chunk;
+}
+
+
+
+template<class Type>
+void Pool<Type>::Storage::Free(void *chunk)
+{
+#ifndef ES_NO_THREADS
+	std::lock_guard<std::mutex> lock(freeMutex);
+#endif // ES_NO_THREADS
+	Chunk *freed = static_cast<Chunk *>(chunk);
+	freed->next = free;
+	free = freed;
+}
+
+
+
+// Allocate a new block of chunks when all the existing ones are in use. The
+// chunk size is a multiple of the object's alignment, so every chunk in the
+// block is aligned as well as the block itself is.
+template<class Type>
+void Pool<Type>::Storage::Grow()
+{
+	static const std::size_t CHUNKS_PER_BLOCK = 32;
+
+	char *block = static_cast<char *>(::operator new(size * CHUNKS_PER_BLOCK));
+	for(std::size_t i = CHUNKS_PER_BLOCK; i--; )
+	{
+		Chunk *chunk = reinterpret_cast<Chunk *>(block + i * size);
+		chunk->next = free;
+		free = chunk;
+	}
+}
+
+
+
+template<class Type>
+template<class T>
+T *Pool<Type>::Allocator<T>::allocate(std::size_t n)
+{
+	if(n != 1)
+		return static_cast<T *>(::operator new(n * sizeof(T)));
+	return static_cast<T *>(GetStorage().Allocate());
+}
+
+
+
+template<class Type>
+template<class T>
+void Pool<Type>::Allocator<T>::deallocate(T *p, std::size_t n)
+{
+	if(n != 1)
+		::operator delete(p);
+	else
+		GetStorage().Free(p);
+}
+
+
+
+template<class Type>
+template<class T>
+typename Pool<Type>::Storage &Pool<Type>::Allocator<T>::GetStorage()
+{
+	static Storage &storage = *new Storage(sizeof(T));
+	return storage;
+}
+
+
+
+#endif
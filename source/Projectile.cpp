@@ -35,6 +35,12 @@ namespace {
 		return (Random::Real() < base * pow(probability, .2));
 	}
 
+	// Check whether projectiles of the given weapon always fly in a straight line.
+	bool IsStraight(const Weapon &weapon)
+	{
+		return !weapon.Turn() && !weapon.Acceleration() && !weapon.Homing() && weapon.LiveEffects().empty();
+	}
+
 	// Returns if the missile is confused or not.
 	bool ConfusedTracking(double tracking, double weaponRange, double jamming, double distance)
 	{
@@ -67,6 +73,11 @@ Projectile::Projectile(const Ship &parent, Point position, Angle angle, const We
 	// If a random lifetime is specified, add a random amount up to that amount.
 	if(weapon->RandomLifetime())
 		lifetime += Random::Int(weapon->RandomLifetime() + 1);
+
+	// Most projectiles never change speed, so the distance that they travel
+	// each step only has to be calculated once.
+	isStraight = IsStraight(*weapon);
+	straightSpeed = dV.Length();
 }
 
 
@@ -91,6 +102,11 @@ Projectile::Projectile(const Projectile &parent, const Point &offset, const Angl
 	// If a random lifetime is specified, add a random amount up to that amount.
 	if(weapon->RandomLifetime())
 		lifetime += Random::Int(weapon->RandomLifetime() + 1);
+
+	// Most projectiles never change speed, so the distance that they travel
+	// each step only has to be calculated once.
+	isStraight = IsStraight(*weapon);
+	straightSpeed = dV.Length();
 }
 
 
@@ -107,6 +123,12 @@ Projectile::Projectile(Point position, const Weapon *weapon)
 // This returns false if it is time to delete this projectile.
 void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
 {
+	if(CanMoveStraight())
+	{
+		MoveStraight();
+		return;
+	}
+
 	if(--lifetime <= 0)
 	{
 		if(lifetime > -100)
@@ -133,19 +155,7 @@ void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
 		if(!Random::Int(it.second))
 			visuals.emplace_back(*it.first, position, velocity, angle);
 
-	// If the target has left the system, stop following it. Also stop if the
-	// target has been captured by a different government.
-	const Ship *target = cachedTarget;
-	if(target)
-	{
-		target = TargetPtr().get();
-		if(!target || !target->IsTargetable() || target->GetGovernment() != targetGovernment)
-		{
-			targetShip.reset();
-			cachedTarget = nullptr;
-			target = nullptr;
-		}
-	}
+	const Ship *target = UpdateTarget();
 
 	double turn = weapon->Turn();
 	double accel = weapon->Acceleration();
@@ -277,6 +287,31 @@ void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
 
 
 
+// Check if this projectile will simply fly in a straight line this step,
+// without steering or creating any effects or submunitions. If so, it can
+// be moved with MoveStraight() instead, which does not use any random
+// numbers and only modifies this projectile.
+bool Projectile::CanMoveStraight() const
+{
+	return isStraight && lifetime > 1;
+}
+
+
+
+void Projectile::MoveStraight()
+{
+	--lifetime;
+	const Ship *target = UpdateTarget();
+
+	position += velocity;
+	distanceTraveled += straightSpeed;
+
+	if(target && (position - target->Position()).Length() < weapon->SplitRange())
+		lifetime = 0;
+}
+
+
+
 // This projectile hit something. Create the explosion, if any. This also
 // marks the projectile as needing deletion.
 void Projectile::Explode(vector<Visual> &visuals, double intersection, Point hitVelocity)
@@ -366,6 +401,26 @@ void Projectile::BreakTarget()
 
 
 
+// Stop following the target if it has left the system or been captured by
+// a different government, and return the target if it is still valid.
+const Ship *Projectile::UpdateTarget()
+{
+	const Ship *target = cachedTarget;
+	if(target)
+	{
+		target = TargetPtr().get();
+		if(!target || !target->IsTargetable() || target->GetGovernment() != targetGovernment)
+		{
+			targetShip.reset();
+			cachedTarget = nullptr;
+			target = nullptr;
+		}
+	}
+	return target;
+}
+
+
+
 // TODO: add more conditions in the future. For example maybe proximity to stars
 // and their brightness could could cause IR missiles to lose their locks more
 // often, and dense asteroid fields could do the same for radar and optically
@@ -66,6 +66,12 @@ public:
 
 	// Move the projectile. It may create effects or submunitions.
 	void Move(std::vector<Visual> &visuals, std::vector<Projectile> &projectiles);
+	// Check if this projectile will simply fly in a straight line this step,
+	// without steering or creating any effects or submunitions. If so, it can
+	// be moved with MoveStraight() instead, which does not use any random
+	// numbers and only modifies this projectile.
+	bool CanMoveStraight() const;
+	void MoveStraight();
 	// This projectile hit something. Create the explosion, if any. This also
 	// marks the projectile as needing deletion.
 	void Explode(std::vector<Visual> &visuals, double intersection, Point hitVelocity = Point());
@@ -98,6 +104,9 @@ public:
 
 
 private:
+	// Stop following the target if it has left the system or been captured by
+	// a different government, and return the target if it is still valid.
+	const Ship *UpdateTarget();
 	void CheckLock(const Ship &target);
 
 
@@ -115,6 +124,10 @@ private:
 	int lifetime = 0;
 	double distanceTraveled = 0;
 	bool hasLock = true;
+	// Projectiles that cannot steer or accelerate and have no live effects
+	// always fly in a straight line, at the speed given by dV.
+	bool isStraight = false;
+	double straightSpeed = 0.;
 };
 
 
@@ -15,6 +15,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Random.h"
 
+#include <atomic>
 #include <random>
 
 #ifndef __linux__
@@ -37,14 +38,83 @@ namespace {
 	thread_local uniform_real_distribution<double> real;
 	thread_local normal_distribution<double> normal;
 #endif
+	// The stream that this thread should use instead of its generator, if any.
+	// Unlike the generators above, this is a plain pointer, so it can be
+	// stored per thread on every platform.
+	thread_local Random::Stream *activeStream = nullptr;
+
+	// The seed that streams are derived from.
+	atomic<uint64_t> masterSeed(0);
+
+	// Scramble the bits of the given value (the "splitmix64" finalizer).
+	uint64_t Mix(uint64_t value)
+	{
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+}
+
+
+
+Random::Stream::Stream(uint64_t seed, uint64_t key)
+	: state(Mix(seed ^ Mix(key + 0x9E3779B97F4A7C15ull)))
+{
+}
+
+
+
+uint32_t Random::Stream::Int()
+{
+	return (*this)() >> 32;
+}
+
+
+
+uint32_t Random::Stream::Int(uint32_t modulus)
+{
+	return (static_cast<uint64_t>(Int()) * static_cast<uint64_t>(modulus)) >> 32;
+}
+
+
+
+// Get a number in the range [0, 1), using the 53 bits that a double can hold.
+double Random::Stream::Real()
+{
+	return ((*this)() >> 11) * (1. / 9007199254740992.);
+}
+
+
+
+Random::Stream::result_type Random::Stream::operator()()
+{
+	state += 0x9E3779B97F4A7C15ull;
+	return Mix(state);
+}
+
+
+
+Random::StreamScope::StreamScope(Stream &stream)
+	: previous(activeStream)
+{
+	activeStream = &stream;
+}
+
+
+
+Random::StreamScope::~StreamScope()
+{
+	activeStream = previous;
 }
 
 
 
 // Seed the generator (e.g. to make it produce exactly the same random
-// numbers it produced previously).
+// numbers it produced previously). This also sets the master seed that
+// streams are derived from.
 void Random::Seed(uint64_t seed)
 {
+	masterSeed = seed;
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
@@ -53,8 +123,19 @@ void Random::Seed(uint64_t seed)
 
 
 
+// Get the stream for the given key (e.g. an index) derived from the most
+// recent seed. The same seed and key always give the same stream.
+Random::Stream Random::GetStream(uint64_t key)
+{
+	return Stream(masterSeed, key);
+}
+
+
+
 uint32_t Random::Int()
 {
+	if(activeStream)
+		return activeStream->Int();
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
@@ -65,6 +146,8 @@ uint32_t Random::Int()
 
 uint32_t Random::Int(uint32_t upper_bound)
 {
+	if(activeStream)
+		return activeStream->Int(upper_bound);
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
@@ -76,6 +159,8 @@ uint32_t Random::Int(uint32_t upper_bound)
 
 double Random::Real()
 {
+	if(activeStream)
+		return activeStream->Real();
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
@@ -89,6 +174,8 @@ double Random::Real()
 uint32_t Random::Polya(uint32_t k, double p)
 {
 	negative_binomial_distribution<uint32_t> polya(k, p);
+	if(activeStream)
+		return polya(*activeStream);
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
@@ -101,6 +188,8 @@ uint32_t Random::Polya(uint32_t k, double p)
 uint32_t Random::Binomial(uint32_t t, double p)
 {
 	binomial_distribution<uint32_t> binomial(t, p);
+	if(activeStream)
+		return binomial(*activeStream);
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
@@ -112,6 +201,10 @@ uint32_t Random::Binomial(uint32_t t, double p)
 // Get a normally distributed number with standard or specified mean and stddev.
 double Random::Normal(double mean, double sigma)
 {
+	// A stream's numbers must not depend on what other streams have drawn, so
+	// it cannot share the cached value of this thread's distribution.
+	if(activeStream)
+		return normal_distribution<double>(mean, sigma)(*activeStream);
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
@@ -24,10 +24,54 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 // different distributions. (This is done partly because on some systems the
 // random number generation is not thread-safe.)
 class Random {
+public:
+	// An independent sequence of random numbers. A stream is cheap to create,
+	// and the numbers it produces depend only on the seed and key it was made
+	// with, so work that is spread across several threads can give each ship
+	// or task its own stream and still produce the same results every time.
+	class Stream {
+	public:
+		using result_type = uint64_t;
+
+		explicit Stream(uint64_t seed = 0, uint64_t key = 0);
+
+		uint32_t Int();
+		uint32_t Int(uint32_t modulus);
+		double Real();
+
+		// Allow this to be used with the standard library's distributions.
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return ~result_type(0); }
+		result_type operator()();
+
+	private:
+		uint64_t state;
+	};
+
+	// While an instance of this class exists, all the static functions below
+	// that are called on the same thread draw from the given stream instead of
+	// from that thread's generator.
+	class StreamScope {
+	public:
+		explicit StreamScope(Stream &stream);
+		~StreamScope();
+
+		StreamScope(const StreamScope &) = delete;
+		StreamScope &operator=(const StreamScope &) = delete;
+
+	private:
+		Stream *previous;
+	};
+
+
 public:
 	// Seed the generator (e.g. to make it produce exactly the same random
-	// numbers it produced previously).
+	// numbers it produced previously). This also sets the master seed that
+	// streams are derived from.
 	static void Seed(uint64_t seed);
+	// Get the stream for the given key (e.g. an index) derived from the most
+	// recent seed. The same seed and key always give the same stream.
+	static Stream GetStream(uint64_t key);
 
 	static uint32_t Int();
 	static uint32_t Int(uint32_t modulus);
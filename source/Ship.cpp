@@ -33,6 +33,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Phrase.h"
 #include "Planet.h"
 #include "PlayerInfo.h"
+#include "Pool.h"
 #include "Preferences.h"
 #include "Projectile.h"
 #include "Random.h"
@@ -67,6 +68,76 @@ namespace {
 
 	const double SCAN_TIME = 600.;
 
+	// Attributes that are looked up every frame.
+	const Dictionary::Key ABSOLUTE_THRESHOLD("absolute threshold");
+	const Dictionary::Key AFTERBURNER_BURN("afterburner burn");
+	const Dictionary::Key AFTERBURNER_CORROSION("afterburner corrosion");
+	const Dictionary::Key AFTERBURNER_DISCHARGE("afterburner discharge");
+	const Dictionary::Key AFTERBURNER_DISRUPTION("afterburner disruption");
+	const Dictionary::Key AFTERBURNER_ENERGY("afterburner energy");
+	const Dictionary::Key AFTERBURNER_FUEL("afterburner fuel");
+	const Dictionary::Key AFTERBURNER_HEAT("afterburner heat");
+	const Dictionary::Key AFTERBURNER_HULL("afterburner hull");
+	const Dictionary::Key AFTERBURNER_ION("afterburner ion");
+	const Dictionary::Key AFTERBURNER_LEAKAGE("afterburner leakage");
+	const Dictionary::Key AFTERBURNER_SCRAMBLE("afterburner scramble");
+	const Dictionary::Key AFTERBURNER_SHIELDS("afterburner shields");
+	const Dictionary::Key AFTERBURNER_SLOWING("afterburner slowing");
+	const Dictionary::Key AFTERBURNER_THRUST("afterburner thrust");
+	const Dictionary::Key CARGO_SCAN_EFFICIENCY("cargo scan efficiency");
+	const Dictionary::Key CARGO_SCAN_POWER("cargo scan power");
+	const Dictionary::Key CARGO_SPACE("cargo space");
+	const Dictionary::Key CLOAK("cloak");
+	const Dictionary::Key CLOAKING_ENERGY("cloaking energy");
+	const Dictionary::Key CLOAKING_FUEL("cloaking fuel");
+	const Dictionary::Key CLOAKING_HEAT("cloaking heat");
+	const Dictionary::Key COOLING_ENERGY("cooling energy");
+	const Dictionary::Key DEPLETED_SHIELD_DELAY("depleted shield delay");
+	const Dictionary::Key DISABLED_REPAIR_DELAY("disabled repair delay");
+	const Dictionary::Key ENERGY_CAPACITY("energy capacity");
+	const Dictionary::Key ENERGY_CONSUMPTION("energy consumption");
+	const Dictionary::Key ENERGY_GENERATION("energy generation");
+	const Dictionary::Key FLOTSAM_CHANCE("flotsam chance");
+	const Dictionary::Key FUEL_CAPACITY("fuel capacity");
+	const Dictionary::Key FUEL_CONSUMPTION("fuel consumption");
+	const Dictionary::Key FUEL_ENERGY("fuel energy");
+	const Dictionary::Key FUEL_GENERATION("fuel generation");
+	const Dictionary::Key FUEL_HEAT("fuel heat");
+	const Dictionary::Key HEAT_CAPACITY("heat capacity");
+	const Dictionary::Key HEAT_GENERATION("heat generation");
+	const Dictionary::Key HULL("hull");
+	const Dictionary::Key HULL_THRESHOLD("hull threshold");
+	const Dictionary::Key INSCRUTABLE("inscrutable");
+	const Dictionary::Key JUMP_SPEED("jump speed");
+	const Dictionary::Key LANDING_SPEED("landing speed");
+	const Dictionary::Key OUTFIT_SCAN_EFFICIENCY("outfit scan efficiency");
+	const Dictionary::Key OUTFIT_SCAN_POWER("outfit scan power");
+	const Dictionary::Key OVERHEAT_DAMAGE_RATE("overheat damage rate");
+	const Dictionary::Key OVERHEAT_DAMAGE_THRESHOLD("overheat damage threshold");
+	const Dictionary::Key RAMSCOOP("ramscoop");
+	const Dictionary::Key REPAIR_DELAY("repair delay");
+	const Dictionary::Key REVERSE_THRUST("reverse thrust");
+	const Dictionary::Key SCRAM_DRIVE("scram drive");
+	const Dictionary::Key SELF_DESTRUCT("self destruct");
+	const Dictionary::Key SHIELDS("shields");
+	const Dictionary::Key SHIELD_DELAY("shield delay");
+	const Dictionary::Key SOLAR_COLLECTION("solar collection");
+	const Dictionary::Key SOLAR_HEAT("solar heat");
+	const Dictionary::Key THRESHOLD_PERCENTAGE("threshold percentage");
+	const Dictionary::Key TURNING_BURN("turning burn");
+	const Dictionary::Key TURNING_CORROSION("turning corrosion");
+	const Dictionary::Key TURNING_DISCHARGE("turning discharge");
+	const Dictionary::Key TURNING_DISRUPTION("turning disruption");
+	const Dictionary::Key TURNING_ENERGY("turning energy");
+	const Dictionary::Key TURNING_FUEL("turning fuel");
+	const Dictionary::Key TURNING_HEAT("turning heat");
+	const Dictionary::Key TURNING_HULL("turning hull");
+	const Dictionary::Key TURNING_ION("turning ion");
+	const Dictionary::Key TURNING_LEAKAGE("turning leakage");
+	const Dictionary::Key TURNING_SCRAMBLE("turning scramble");
+	const Dictionary::Key TURNING_SHIELDS("turning shields");
+	const Dictionary::Key TURNING_SLOWING("turning slowing");
+
 	// Helper function to transfer energy to a given stat if it is less than the
 	// given maximum value.
 	void DoRepair(double &stat, double &available, double maximum)
@@ -747,6 +818,9 @@ void Ship::FinishLoading(bool isNewInstance)
 	// Allocate enough firing bits for this ship.
 	firingCommands.SetHardpoints(armament.Get().size());
 
+	// Cache the values that are derived from this ship's attributes.
+	stats.Calibrate(*this);
+
 	// If this ship is being instantiated for the first time, make sure its
 	// crew, fuel, etc. are all refilled.
 	if(isNewInstance)
@@ -786,6 +860,7 @@ void Ship::FinishLoading(bool isNewInstance)
 	{
 		warning += "Defaulting " + string(attributes.Get("drag") ? "invalid" : "missing") + " \"drag\" attribute to 100.0\n";
 		attributes.Set("drag", 100.);
+		stats.Calibrate(*this);
 	}
 
 	// Calculate the values used to determine this ship's value and danger.
@@ -1580,16 +1655,16 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		if(!cloak)
 			cloakDisruption = max(0., cloakDisruption - 1.);
 
-		double cloakingSpeed = attributes.Get("cloak");
+		double cloakingSpeed = attributes.Get(CLOAK);
 		bool canCloak = (!isDisabled && cloakingSpeed > 0. && !cloakDisruption
-			&& fuel >= attributes.Get("cloaking fuel")
-			&& energy >= attributes.Get("cloaking energy"));
+			&& fuel >= attributes.Get(CLOAKING_FUEL)
+			&& energy >= attributes.Get(CLOAKING_ENERGY));
 		if(commands.Has(Command::CLOAK) && canCloak)
 		{
 			cloak = min(1., cloak + cloakingSpeed);
-			fuel -= attributes.Get("cloaking fuel");
-			energy -= attributes.Get("cloaking energy");
-			heat += attributes.Get("cloaking heat");
+			fuel -= attributes.Get(CLOAKING_FUEL);
+			energy -= attributes.Get(CLOAKING_ENERGY);
+			heat += attributes.Get(CLOAKING_HEAT);
 		}
 		else if(cloakingSpeed)
 		{
@@ -1648,7 +1723,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				// Ammunition has a default 5% chance to survive as flotsam.
 				for(const auto &it : outfits)
 				{
-					double flotsamChance = it.first->Get("flotsam chance");
+					double flotsamChance = it.first->Get(FLOTSAM_CHANCE);
 					if(flotsamChance > 0.)
 						Jettison(it.first, Random::Binomial(it.second, flotsamChance));
 					// 0 valued 'flotsamChance' means default, which is 5% for ammunition.
@@ -1857,7 +1932,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		if(isDisabled)
 			landingPlanet = nullptr;
 
-		float landingSpeed = attributes.Get("landing speed");
+		float landingSpeed = attributes.Get(LANDING_SPEED);
 		landingSpeed = landingSpeed > 0 ? landingSpeed : .02f;
 		// Special ships do not disappear forever when they land; they
 		// just slowly refuel.
@@ -1892,7 +1967,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 			}
 		}
 		// Only refuel if this planet has a spaceport.
-		else if(fuel >= attributes.Get("fuel capacity")
+		else if(fuel >= attributes.Get(FUEL_CAPACITY)
 				|| !landingPlanet || !landingPlanet->HasSpaceport())
 		{
 			zoom = min(1.f, zoom + landingSpeed);
@@ -1900,7 +1975,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 			landingPlanet = nullptr;
 		}
 		else
-			fuel = min(fuel + 1., attributes.Get("fuel capacity"));
+			fuel = min(fuel + 1., attributes.Get(FUEL_CAPACITY));
 
 		// Move the ship at the velocity it had when it began landing, but
 		// scaled based on how small it is now.
@@ -1958,23 +2033,23 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		if(commands.Turn())
 		{
 			// Check if we are able to turn.
-			double cost = attributes.Get("turning energy");
+			double cost = attributes.Get(TURNING_ENERGY);
 			if(cost > 0. && energy < cost * fabs(commands.Turn()))
 				commands.SetTurn(commands.Turn() * energy / (cost * fabs(commands.Turn())));
 
-			cost = attributes.Get("turning shields");
+			cost = attributes.Get(TURNING_SHIELDS);
 			if(cost > 0. && shields < cost * fabs(commands.Turn()))
 				commands.SetTurn(commands.Turn() * shields / (cost * fabs(commands.Turn())));
 
-			cost = attributes.Get("turning hull");
+			cost = attributes.Get(TURNING_HULL);
 			if(cost > 0. && hull < cost * fabs(commands.Turn()))
 				commands.SetTurn(commands.Turn() * hull / (cost * fabs(commands.Turn())));
 
-			cost = attributes.Get("turning fuel");
+			cost = attributes.Get(TURNING_FUEL);
 			if(cost > 0. && fuel < cost * fabs(commands.Turn()))
 				commands.SetTurn(commands.Turn() * fuel / (cost * fabs(commands.Turn())));
 
-			cost = -attributes.Get("turning heat");
+			cost = -attributes.Get(TURNING_HEAT);
 			if(cost > 0. && heat < cost * fabs(commands.Turn()))
 				commands.SetTurn(commands.Turn() * heat / (cost * fabs(commands.Turn())));
 
@@ -1987,19 +2062,19 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				// of the turning energy and produce a fraction of the heat.
 				double scale = fabs(commands.Turn());
 
-				shields -= scale * attributes.Get("turning shields");
-				hull -= scale * attributes.Get("turning hull");
-				energy -= scale * attributes.Get("turning energy");
-				fuel -= scale * attributes.Get("turning fuel");
-				heat += scale * attributes.Get("turning heat");
-				discharge += scale * attributes.Get("turning discharge");
-				corrosion += scale * attributes.Get("turning corrosion");
-				ionization += scale * attributes.Get("turning ion");
-				scrambling += scale * attributes.Get("turning scramble");
-				leakage += scale * attributes.Get("turning leakage");
-				burning += scale * attributes.Get("turning burn");
-				slowness += scale * attributes.Get("turning slowing");
-				disruption += scale * attributes.Get("turning disruption");
+				shields -= scale * attributes.Get(TURNING_SHIELDS);
+				hull -= scale * attributes.Get(TURNING_HULL);
+				energy -= scale * attributes.Get(TURNING_ENERGY);
+				fuel -= scale * attributes.Get(TURNING_FUEL);
+				heat += scale * attributes.Get(TURNING_HEAT);
+				discharge += scale * attributes.Get(TURNING_DISCHARGE);
+				corrosion += scale * attributes.Get(TURNING_CORROSION);
+				ionization += scale * attributes.Get(TURNING_ION);
+				scrambling += scale * attributes.Get(TURNING_SCRAMBLE);
+				leakage += scale * attributes.Get(TURNING_LEAKAGE);
+				burning += scale * attributes.Get(TURNING_BURN);
+				slowness += scale * attributes.Get(TURNING_SLOWING);
+				disruption += scale * attributes.Get(TURNING_DISRUPTION);
 
 				angle += commands.Turn() * TurnRate() * slowMultiplier;
 			}
@@ -2039,7 +2114,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				// If a reverse thrust is commanded and the capability does not
 				// exist, ignore it (do not even slow under drag).
 				isThrusting = (thrustCommand > 0.);
-				isReversing = !isThrusting && attributes.Get("reverse thrust");
+				isReversing = !isThrusting && attributes.Get(REVERSE_THRUST);
 				thrust = attributes.Get(isThrusting ? "thrust" : "reverse thrust");
 				if(thrust)
 				{
@@ -2068,22 +2143,22 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				&& !CannotAct();
 		if(applyAfterburner)
 		{
-			thrust = attributes.Get("afterburner thrust");
-			double shieldCost = attributes.Get("afterburner shields");
-			double hullCost = attributes.Get("afterburner hull");
-			double energyCost = attributes.Get("afterburner energy");
-			double fuelCost = attributes.Get("afterburner fuel");
-			double heatCost = -attributes.Get("afterburner heat");
-
-			double dischargeCost = attributes.Get("afterburner discharge");
-			double corrosionCost = attributes.Get("afterburner corrosion");
-			double ionCost = attributes.Get("afterburner ion");
-			double scramblingCost = attributes.Get("afterburner scramble");
-			double leakageCost = attributes.Get("afterburner leakage");
-			double burningCost = attributes.Get("afterburner burn");
-
-			double slownessCost = attributes.Get("afterburner slowing");
-			double disruptionCost = attributes.Get("afterburner disruption");
+			thrust = attributes.Get(AFTERBURNER_THRUST);
+			double shieldCost = attributes.Get(AFTERBURNER_SHIELDS);
+			double hullCost = attributes.Get(AFTERBURNER_HULL);
+			double energyCost = attributes.Get(AFTERBURNER_ENERGY);
+			double fuelCost = attributes.Get(AFTERBURNER_FUEL);
+			double heatCost = -attributes.Get(AFTERBURNER_HEAT);
+
+			double dischargeCost = attributes.Get(AFTERBURNER_DISCHARGE);
+			double corrosionCost = attributes.Get(AFTERBURNER_CORROSION);
+			double ionCost = attributes.Get(AFTERBURNER_ION);
+			double scramblingCost = attributes.Get(AFTERBURNER_SCRAMBLE);
+			double leakageCost = attributes.Get(AFTERBURNER_LEAKAGE);
+			double burningCost = attributes.Get(AFTERBURNER_BURN);
+
+			double slownessCost = attributes.Get(AFTERBURNER_SLOWING);
+			double disruptionCost = attributes.Get(AFTERBURNER_DISRUPTION);
 
 			if(thrust && shields >= shieldCost && hull >= hullCost
 				&& energy >= energyCost && fuel >= fuelCost && heat >= heatCost)
@@ -2195,7 +2270,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				{
 					isBoarding = false;
 					bool isEnemy = government->IsEnemy(target->government);
-					if(isEnemy && Random::Real() < target->Attributes().Get("self destruct"))
+					if(isEnemy && Random::Real() < target->Attributes().Get(SELF_DESTRUCT))
 					{
 						Messages::Add("The " + target->ModelName() + " \"" + target->Name()
 							+ "\" has activated its self-destruct mechanism.", Messages::Importance::High);
@@ -2249,29 +2324,21 @@ void Ship::DoGeneration()
 		// 4. Shields of carried fighters
 		// 5. Transfer of excess energy and fuel to carried fighters.
 
-		const double hullAvailable = attributes.Get("hull repair rate")
-			* (1. + attributes.Get("hull repair multiplier"));
-		const double hullEnergy = (attributes.Get("hull energy")
-			* (1. + attributes.Get("hull energy multiplier"))) / hullAvailable;
-		const double hullFuel = (attributes.Get("hull fuel")
-			* (1. + attributes.Get("hull fuel multiplier"))) / hullAvailable;
-		const double hullHeat = (attributes.Get("hull heat")
-			* (1. + attributes.Get("hull heat multiplier"))) / hullAvailable;
-		double hullRemaining = hullAvailable;
+		const ShipStats::Repair &hullRepair = stats.HullRepair();
+		const double hullEnergy = hullRepair.energy;
+		const double hullFuel = hullRepair.fuel;
+		const double hullHeat = hullRepair.heat;
+		double hullRemaining = hullRepair.available;
 		if(!hullDelay)
-			DoRepair(hull, hullRemaining, attributes.Get("hull"), energy, hullEnergy, fuel, hullFuel, heat, hullHeat);
-
-		const double shieldsAvailable = attributes.Get("shield generation")
-			* (1. + attributes.Get("shield generation multiplier"));
-		const double shieldsEnergy = (attributes.Get("shield energy")
-			* (1. + attributes.Get("shield energy multiplier"))) / shieldsAvailable;
-		const double shieldsFuel = (attributes.Get("shield fuel")
-			* (1. + attributes.Get("shield fuel multiplier"))) / shieldsAvailable;
-		const double shieldsHeat = (attributes.Get("shield heat")
-			* (1. + attributes.Get("shield heat multiplier"))) / shieldsAvailable;
-		double shieldsRemaining = shieldsAvailable;
+			DoRepair(hull, hullRemaining, attributes.Get(HULL), energy, hullEnergy, fuel, hullFuel, heat, hullHeat);
+
+		const ShipStats::Repair &shieldRepair = stats.ShieldRepair();
+		const double shieldsEnergy = shieldRepair.energy;
+		const double shieldsFuel = shieldRepair.fuel;
+		const double shieldsHeat = shieldRepair.heat;
+		double shieldsRemaining = shieldRepair.available;
 		if(!shieldDelay)
-			DoRepair(shields, shieldsRemaining, attributes.Get("shields"),
+			DoRepair(shields, shieldsRemaining, attributes.Get(SHIELDS),
 				energy, shieldsEnergy, fuel, shieldsFuel, heat, shieldsHeat);
 
 		if(!bays.empty())
@@ -2296,24 +2363,24 @@ void Ship::DoGeneration()
 			{
 				Ship &ship = *it.second;
 				if(!hullDelay)
-					DoRepair(ship.hull, hullRemaining, ship.attributes.Get("hull"),
+					DoRepair(ship.hull, hullRemaining, ship.attributes.Get(HULL),
 						energy, hullEnergy, heat, hullHeat, fuel, hullFuel);
 				if(!shieldDelay)
-					DoRepair(ship.shields, shieldsRemaining, ship.attributes.Get("shields"),
+					DoRepair(ship.shields, shieldsRemaining, ship.attributes.Get(SHIELDS),
 						energy, shieldsEnergy, heat, shieldsHeat, fuel, shieldsFuel);
 			}
 
 			// Now that there is no more need to use energy for hull and shield
 			// repair, if there is still excess energy, transfer it.
-			double energyRemaining = energy - attributes.Get("energy capacity");
-			double fuelRemaining = fuel - attributes.Get("fuel capacity");
+			double energyRemaining = energy - attributes.Get(ENERGY_CAPACITY);
+			double fuelRemaining = fuel - attributes.Get(FUEL_CAPACITY);
 			for(const pair<double, Ship *> &it : carried)
 			{
 				Ship &ship = *it.second;
 				if(energyRemaining > 0.)
-					DoRepair(ship.energy, energyRemaining, ship.attributes.Get("energy capacity"));
+					DoRepair(ship.energy, energyRemaining, ship.attributes.Get(ENERGY_CAPACITY));
 				if(fuelRemaining > 0.)
-					DoRepair(ship.fuel, fuelRemaining, ship.attributes.Get("fuel capacity"));
+					DoRepair(ship.fuel, fuelRemaining, ship.attributes.Get(FUEL_CAPACITY));
 			}
 		}
 		// Decrease the shield and hull delays by 1 now that shield generation
@@ -2331,105 +2398,81 @@ void Ship::DoGeneration()
 	// TODO: Mothership gives status resistance to carried ships?
 	if(ionization)
 	{
-		double ionResistance = attributes.Get("ion resistance");
-		double ionEnergy = attributes.Get("ion resistance energy") / ionResistance;
-		double ionFuel = attributes.Get("ion resistance fuel") / ionResistance;
-		double ionHeat = attributes.Get("ion resistance heat") / ionResistance;
-		DoStatusEffect(isDisabled, ionization, ionResistance,
-			energy, ionEnergy, fuel, ionFuel, heat, ionHeat);
+		const ShipStats::Resistance &ionResistance = stats.IonResistance();
+		DoStatusEffect(isDisabled, ionization, ionResistance.resistance,
+			energy, ionResistance.energy, fuel, ionResistance.fuel, heat, ionResistance.heat);
 	}
 
 	if(scrambling)
 	{
-		double scramblingResistance = attributes.Get("scramble resistance");
-		double scramblingEnergy = attributes.Get("scramble resistance energy") / scramblingResistance;
-		double scramblingFuel = attributes.Get("scramble resistance fuel") / scramblingResistance;
-		double scramblingHeat = attributes.Get("scramble resistance heat") / scramblingResistance;
-		DoStatusEffect(isDisabled, scrambling, scramblingResistance,
-			energy, scramblingEnergy, fuel, scramblingFuel, heat, scramblingHeat);
+		const ShipStats::Resistance &scramblingResistance = stats.ScramblingResistance();
+		DoStatusEffect(isDisabled, scrambling, scramblingResistance.resistance,
+			energy, scramblingResistance.energy, fuel, scramblingResistance.fuel, heat, scramblingResistance.heat);
 	}
 
 	if(disruption)
 	{
-		double disruptionResistance = attributes.Get("disruption resistance");
-		double disruptionEnergy = attributes.Get("disruption resistance energy") / disruptionResistance;
-		double disruptionFuel = attributes.Get("disruption resistance fuel") / disruptionResistance;
-		double disruptionHeat = attributes.Get("disruption resistance heat") / disruptionResistance;
-		DoStatusEffect(isDisabled, disruption, disruptionResistance,
-			energy, disruptionEnergy, fuel, disruptionFuel, heat, disruptionHeat);
+		const ShipStats::Resistance &disruptionResistance = stats.DisruptionResistance();
+		DoStatusEffect(isDisabled, disruption, disruptionResistance.resistance,
+			energy, disruptionResistance.energy, fuel, disruptionResistance.fuel, heat, disruptionResistance.heat);
 	}
 
 	if(slowness)
 	{
-		double slowingResistance = attributes.Get("slowing resistance");
-		double slowingEnergy = attributes.Get("slowing resistance energy") / slowingResistance;
-		double slowingFuel = attributes.Get("slowing resistance fuel") / slowingResistance;
-		double slowingHeat = attributes.Get("slowing resistance heat") / slowingResistance;
-		DoStatusEffect(isDisabled, slowness, slowingResistance,
-			energy, slowingEnergy, fuel, slowingFuel, heat, slowingHeat);
+		const ShipStats::Resistance &slowingResistance = stats.SlowingResistance();
+		DoStatusEffect(isDisabled, slowness, slowingResistance.resistance,
+			energy, slowingResistance.energy, fuel, slowingResistance.fuel, heat, slowingResistance.heat);
 	}
 
 	if(discharge)
 	{
-		double dischargeResistance = attributes.Get("discharge resistance");
-		double dischargeEnergy = attributes.Get("discharge resistance energy") / dischargeResistance;
-		double dischargeFuel = attributes.Get("discharge resistance fuel") / dischargeResistance;
-		double dischargeHeat = attributes.Get("discharge resistance heat") / dischargeResistance;
-		DoStatusEffect(isDisabled, discharge, dischargeResistance,
-			energy, dischargeEnergy, fuel, dischargeFuel, heat, dischargeHeat);
+		const ShipStats::Resistance &dischargeResistance = stats.DischargeResistance();
+		DoStatusEffect(isDisabled, discharge, dischargeResistance.resistance,
+			energy, dischargeResistance.energy, fuel, dischargeResistance.fuel, heat, dischargeResistance.heat);
 	}
 
 	if(corrosion)
 	{
-		double corrosionResistance = attributes.Get("corrosion resistance");
-		double corrosionEnergy = attributes.Get("corrosion resistance energy") / corrosionResistance;
-		double corrosionFuel = attributes.Get("corrosion resistance fuel") / corrosionResistance;
-		double corrosionHeat = attributes.Get("corrosion resistance heat") / corrosionResistance;
-		DoStatusEffect(isDisabled, corrosion, corrosionResistance,
-			energy, corrosionEnergy, fuel, corrosionFuel, heat, corrosionHeat);
+		const ShipStats::Resistance &corrosionResistance = stats.CorrosionResistance();
+		DoStatusEffect(isDisabled, corrosion, corrosionResistance.resistance,
+			energy, corrosionResistance.energy, fuel, corrosionResistance.fuel, heat, corrosionResistance.heat);
 	}
 
 	if(leakage)
 	{
-		double leakResistance = attributes.Get("leak resistance");
-		double leakEnergy = attributes.Get("leak resistance energy") / leakResistance;
-		double leakFuel = attributes.Get("leak resistance fuel") / leakResistance;
-		double leakHeat = attributes.Get("leak resistance heat") / leakResistance;
-		DoStatusEffect(isDisabled, leakage, leakResistance,
-			energy, leakEnergy, fuel, leakFuel, heat, leakHeat);
+		const ShipStats::Resistance &leakResistance = stats.LeakResistance();
+		DoStatusEffect(isDisabled, leakage, leakResistance.resistance,
+			energy, leakResistance.energy, fuel, leakResistance.fuel, heat, leakResistance.heat);
 	}
 
 	if(burning)
 	{
-		double burnResistance = attributes.Get("burn resistance");
-		double burnEnergy = attributes.Get("burn resistance energy") / burnResistance;
-		double burnFuel = attributes.Get("burn resistance fuel") / burnResistance;
-		double burnHeat = attributes.Get("burn resistance heat") / burnResistance;
-		DoStatusEffect(isDisabled, burning, burnResistance,
-			energy, burnEnergy, fuel, burnFuel, heat, burnHeat);
+		const ShipStats::Resistance &burnResistance = stats.BurnResistance();
+		DoStatusEffect(isDisabled, burning, burnResistance.resistance,
+			energy, burnResistance.energy, fuel, burnResistance.fuel, heat, burnResistance.heat);
 	}
 
 	// When ships recharge, what actually happens is that they can exceed their
 	// maximum capacity for the rest of the turn, but must be clamped to the
 	// maximum here before they gain more. This is so that, for example, a ship
 	// with no batteries but a good generator can still move.
-	energy = min(energy, attributes.Get("energy capacity"));
-	fuel = min(fuel, attributes.Get("fuel capacity"));
+	energy = min(energy, attributes.Get(ENERGY_CAPACITY));
+	fuel = min(fuel, attributes.Get(FUEL_CAPACITY));
 
 	heat -= heat * HeatDissipation();
 	if(heat > MaximumHeat())
 	{
 		isOverheated = true;
-		double heatRatio = Heat() / (1. + attributes.Get("overheat damage threshold"));
+		double heatRatio = Heat() / (1. + attributes.Get(OVERHEAT_DAMAGE_THRESHOLD));
 		if(heatRatio > 1.)
-			hull -= attributes.Get("overheat damage rate") * heatRatio;
+			hull -= attributes.Get(OVERHEAT_DAMAGE_RATE) * heatRatio;
 	}
 	else if(heat < .9 * MaximumHeat())
 		isOverheated = false;
 
-	double maxShields = attributes.Get("shields");
+	double maxShields = attributes.Get(SHIELDS);
 	shields = min(shields, maxShields);
-	double maxHull = attributes.Get("hull");
+	double maxHull = attributes.Get(HULL);
 	hull = min(hull, maxHull);
 
 	isDisabled = isOverheated || hull < MinimumHull() || (!crew && RequiredCrew());
@@ -2444,35 +2487,34 @@ void Ship::DoGeneration()
 		if(currentSystem)
 		{
 			double scale = .2 + 1.8 / (.001 * position.Length() + 1);
-			fuel += currentSystem->RamscoopFuel(attributes.Get("ramscoop"), scale);
+			fuel += currentSystem->RamscoopFuel(attributes.Get(RAMSCOOP), scale);
 
 			double solarScaling = currentSystem->SolarPower() * scale;
-			energy += solarScaling * attributes.Get("solar collection");
-			heat += solarScaling * attributes.Get("solar heat");
+			energy += solarScaling * attributes.Get(SOLAR_COLLECTION);
+			heat += solarScaling * attributes.Get(SOLAR_HEAT);
 		}
 
-		double coolingEfficiency = CoolingEfficiency();
-		energy += attributes.Get("energy generation") - attributes.Get("energy consumption");
-		fuel += attributes.Get("fuel generation");
-		heat += attributes.Get("heat generation");
-		heat -= coolingEfficiency * attributes.Get("cooling");
+		energy += attributes.Get(ENERGY_GENERATION) - attributes.Get(ENERGY_CONSUMPTION);
+		fuel += attributes.Get(FUEL_GENERATION);
+		heat += attributes.Get(HEAT_GENERATION);
+		heat -= stats.Cooling();
 
 		// Convert fuel into energy and heat only when the required amount of fuel is available.
-		if(attributes.Get("fuel consumption") <= fuel)
+		if(attributes.Get(FUEL_CONSUMPTION) <= fuel)
 		{
-			fuel -= attributes.Get("fuel consumption");
-			energy += attributes.Get("fuel energy");
-			heat += attributes.Get("fuel heat");
+			fuel -= attributes.Get(FUEL_CONSUMPTION);
+			energy += attributes.Get(FUEL_ENERGY);
+			heat += attributes.Get(FUEL_HEAT);
 		}
 
 		// Apply active cooling. The fraction of full cooling to apply equals
 		// your ship's current fraction of its maximum temperature.
-		double activeCooling = coolingEfficiency * attributes.Get("active cooling");
+		double activeCooling = stats.ActiveCooling();
 		if(activeCooling > 0. && heat > 0. && energy >= 0.)
 		{
 			// Handle the case where "active cooling"
 			// does not require any energy.
-			double coolingEnergy = attributes.Get("cooling energy");
+			double coolingEnergy = attributes.Get(COOLING_ENERGY);
 			if(coolingEnergy)
 			{
 				double spentEnergy = min(energy, coolingEnergy * min(1., Heat()));
@@ -2650,18 +2692,18 @@ int Ship::Scan(const PlayerInfo &player)
 
 	// The range of a scanner is proportional to the square root of its power.
 	// Because of Pythagoras, if we use square-distance, we can skip this square root.
-	double cargoDistanceSquared = attributes.Get("cargo scan power");
-	double outfitDistanceSquared = attributes.Get("outfit scan power");
+	double cargoDistanceSquared = attributes.Get(CARGO_SCAN_POWER);
+	double outfitDistanceSquared = attributes.Get(OUTFIT_SCAN_POWER);
 
 	// Bail out if this ship has no scanners.
 	if(!cargoDistanceSquared && !outfitDistanceSquared)
 		return 0;
 
-	double cargoSpeed = attributes.Get("cargo scan efficiency");
+	double cargoSpeed = attributes.Get(CARGO_SCAN_EFFICIENCY);
 	if(!cargoSpeed)
 		cargoSpeed = cargoDistanceSquared;
 
-	double outfitSpeed = attributes.Get("outfit scan efficiency");
+	double outfitSpeed = attributes.Get(OUTFIT_SCAN_EFFICIENCY);
 	if(!outfitSpeed)
 		outfitSpeed = outfitDistanceSquared;
 
@@ -2677,7 +2719,7 @@ int Ship::Scan(const PlayerInfo &player)
 	// causing a divide by zero error at sizes of 0.
 	// If instantly scanning very small ships is desirable, this can be removed.
 	double outfits = max(10., target->baseAttributes.Get("outfit space")) * .005;
-	double cargo = max(10., target->attributes.Get("cargo space")) * .005;
+	double cargo = max(10., target->attributes.Get(CARGO_SPACE)) * .005;
 
 	// Check if either scanner has finished scanning.
 	bool startedScanning = false;
@@ -2761,7 +2803,7 @@ int Ship::Scan(const PlayerInfo &player)
 		if(result & ShipEvent::SCAN_OUTFITS)
 			Messages::Add("The " + government->GetName() + " " + Noun() + " \""
 					+ Name() + "\" completed its outfit scan of your ship \"" + target->Name()
-					+ (target->Attributes().Get("inscrutable") > 0. ? "\" with no useful results." : "\"."),
+					+ (target->Attributes().Get(INSCRUTABLE) > 0. ? "\" with no useful results." : "\"."),
 					Messages::Importance::High);
 	}
 
@@ -3002,7 +3044,7 @@ bool Ship::IsReadyToJump(bool waitingIsReady) const
 
 	Point direction = targetSystem->Position() - currentSystem->Position();
 	bool isJump = (jumpUsed.first == JumpType::JUMP_DRIVE);
-	double scramThreshold = attributes.Get("scram drive");
+	double scramThreshold = attributes.Get(SCRAM_DRIVE);
 
 	// If the system has a departure distance the ship is only allowed to leave the system
 	// if it is beyond this distance.
@@ -3021,7 +3063,7 @@ bool Ship::IsReadyToJump(bool waitingIsReady) const
 		if(deviation > scramThreshold)
 			return false;
 	}
-	else if(velocity.Length() > attributes.Get("jump speed"))
+	else if(velocity.Length() > attributes.Get(JUMP_SPEED))
 		return false;
 
 	if(!isJump)
@@ -3140,7 +3182,7 @@ void Ship::Restore()
 bool Ship::IsDamaged() const
 {
 	// Account for ships with no shields when determining if they're damaged.
-	return (attributes.Get("shields") != 0 && Shields() != 1.) || Hull() != 1.;
+	return (attributes.Get(SHIELDS) != 0 && Shields() != 1.) || Hull() != 1.;
 }
 
 
@@ -3283,7 +3325,7 @@ void Ship::ClearTargetsAndOrders()
 // Get characteristics of this ship, as a fraction between 0 and 1.
 double Ship::Shields() const
 {
-	double maximum = attributes.Get("shields");
+	double maximum = attributes.Get(SHIELDS);
 	return maximum ? min(1., shields / maximum) : 0.;
 }
 
@@ -3291,7 +3333,7 @@ double Ship::Shields() const
 
 double Ship::Hull() const
 {
-	double maximum = attributes.Get("hull");
+	double maximum = attributes.Get(HULL);
 	return maximum ? min(1., hull / maximum) : 1.;
 }
 
@@ -3299,7 +3341,7 @@ double Ship::Hull() const
 
 double Ship::Fuel() const
 {
-	double maximum = attributes.Get("fuel capacity");
+	double maximum = attributes.Get(FUEL_CAPACITY);
 	return maximum ? min(1., fuel / maximum) : 0.;
 }
 
@@ -3307,7 +3349,7 @@ double Ship::Fuel() const
 
 double Ship::Energy() const
 {
-	double maximum = attributes.Get("energy capacity");
+	double maximum = attributes.Get(ENERGY_CAPACITY);
 	return maximum ? min(1., energy / maximum) : (hull > 0.) ? 1. : 0.;
 }
 
@@ -3327,8 +3369,8 @@ double Ship::Heat() const
 double Ship::Health() const
 {
 	double minimumHull = MinimumHull();
-	double hullDivisor = attributes.Get("hull") - minimumHull;
-	double divisor = attributes.Get("shields") + hullDivisor;
+	double hullDivisor = attributes.Get(HULL) - minimumHull;
+	double divisor = attributes.Get(SHIELDS) + hullDivisor;
 	// This should not happen, but just in case.
 	if(divisor <= 0. || hullDivisor <= 0.)
 		return 0.;
@@ -3343,7 +3385,7 @@ double Ship::Health() const
 // Get the hull fraction at which this ship is disabled.
 double Ship::DisabledHull() const
 {
-	double hull = attributes.Get("hull");
+	double hull = attributes.Get(HULL);
 	double minimumHull = MinimumHull();
 
 	return (hull > 0. ? minimumHull / hull : 0.);
@@ -3420,7 +3462,7 @@ bool Ship::NeedsFuel(bool followParent) const
 	}
 	if(!jumpFuel)
 		jumpFuel = navigation.JumpFuel(targetSystem);
-	return (fuel < jumpFuel) && (attributes.Get("fuel capacity") >= jumpFuel);
+	return (fuel < jumpFuel) && (attributes.Get(FUEL_CAPACITY) >= jumpFuel);
 }
 
 
@@ -3430,7 +3472,7 @@ double Ship::JumpFuelMissing() const
 	// Used for smart refueling: transfer only as much as really needed
 	// includes checking if fuel cap is high enough at all
 	double jumpFuel = navigation.JumpFuel(targetSystem);
-	if(!jumpFuel || fuel > jumpFuel || jumpFuel > attributes.Get("fuel capacity"))
+	if(!jumpFuel || fuel > jumpFuel || jumpFuel > attributes.Get(FUEL_CAPACITY))
 		return 0.;
 
 	return jumpFuel - fuel;
@@ -3442,15 +3484,14 @@ double Ship::JumpFuelMissing() const
 double Ship::IdleHeat() const
 {
 	// This ship's cooling ability:
-	double coolingEfficiency = CoolingEfficiency();
-	double cooling = coolingEfficiency * attributes.Get("cooling");
-	double activeCooling = coolingEfficiency * attributes.Get("active cooling");
+	double cooling = stats.Cooling();
+	double activeCooling = stats.ActiveCooling();
 
 	// Idle heat is the heat level where:
 	// heat = heat * diss + heatGen - cool - activeCool * heat / (100 * mass)
 	// heat = heat * (diss - activeCool / (100 * mass)) + (heatGen - cool)
 	// heat * (1 - diss + activeCool / (100 * mass)) = (heatGen - cool)
-	double production = max(0., attributes.Get("heat generation") - cooling);
+	double production = max(0., attributes.Get(HEAT_GENERATION) - cooling);
 	double dissipation = HeatDissipation() + activeCooling / MaximumHeat();
 	if(!dissipation) return production ? numeric_limits<double>::max() : 0;
 	return production / dissipation;
@@ -3461,7 +3502,7 @@ double Ship::IdleHeat() const
 // Get the heat dissipation, in heat units per heat unit per frame.
 double Ship::HeatDissipation() const
 {
-	return .001 * attributes.Get("heat dissipation");
+	return stats.HeatDissipation();
 }
 
 
@@ -3469,7 +3510,7 @@ double Ship::HeatDissipation() const
 // Get the maximum heat level, in heat units (not temperature).
 double Ship::MaximumHeat() const
 {
-	return MAXIMUM_TEMPERATURE * (cargo.Used() + attributes.Mass() + attributes.Get("heat capacity"));
+	return MAXIMUM_TEMPERATURE * (cargo.Used() + attributes.Mass() + attributes.Get(HEAT_CAPACITY));
 }
 
 
@@ -3477,11 +3518,7 @@ double Ship::MaximumHeat() const
 // Calculate the multiplier for cooling efficiency.
 double Ship::CoolingEfficiency() const
 {
-	// This is an S-curve where the efficiency is 100% if you have no outfits
-	// that create "cooling inefficiency", and as that value increases the
-	// efficiency stays high for a while, then drops off, then approaches 0.
-	double x = attributes.Get("cooling inefficiency");
-	return 2. + 2. / (1. + exp(x / -2.)) - 4. / (1. + exp(x / -4.));
+	return stats.CoolingEfficiency();
 }
 
 
@@ -3496,7 +3533,7 @@ int Ship::Crew() const
 // Calculate drag, accounting for drag reduction.
 double Ship::Drag() const
 {
-	return attributes.Get("drag") / (1. + attributes.Get("drag reduction"));
+	return stats.Drag();
 }
 
 
@@ -3544,22 +3581,21 @@ double Ship::Mass() const
 // Account for inertia reduction, which affects movement but has no effect on the ship's heat capacity.
 double Ship::InertialMass() const
 {
-	return Mass() / (1. + attributes.Get("inertia reduction"));
+	return Mass() / stats.InertiaDivisor();
 }
 
 
 
 double Ship::TurnRate() const
 {
-	return attributes.Get("turn") / InertialMass();
+	return stats.Turn() / InertialMass();
 }
 
 
 
 double Ship::Acceleration() const
 {
-	double thrust = attributes.Get("thrust");
-	return (thrust ? thrust : attributes.Get("afterburner thrust")) / InertialMass();
+	return stats.Thrust() / InertialMass();
 }
 
 
@@ -3569,22 +3605,21 @@ double Ship::MaxVelocity() const
 	// v * drag / mass == thrust / mass
 	// v * drag == thrust
 	// v = thrust / drag
-	double thrust = attributes.Get("thrust");
-	return (thrust ? thrust : attributes.Get("afterburner thrust")) / Drag();
+	return stats.Thrust() / Drag();
 }
 
 
 
 double Ship::ReverseAcceleration() const
 {
-	return attributes.Get("reverse thrust");
+	return attributes.Get(REVERSE_THRUST);
 }
 
 
 
 double Ship::MaxReverseVelocity() const
 {
-	return attributes.Get("reverse thrust") / Drag();
+	return attributes.Get(REVERSE_THRUST) / Drag();
 }
 
 
@@ -3601,13 +3636,13 @@ int Ship::TakeDamage(vector<Visual> &visuals, const DamageDealt &damage, const G
 	shields -= damage.Shield();
 	if(damage.Shield() && !isDisabled)
 	{
-		int disabledDelay = attributes.Get("depleted shield delay");
+		int disabledDelay = attributes.Get(DEPLETED_SHIELD_DELAY);
 		shieldDelay = max<int>(shieldDelay, (shields <= 0. && disabledDelay)
-			? disabledDelay : attributes.Get("shield delay"));
+			? disabledDelay : attributes.Get(SHIELD_DELAY));
 	}
 	hull -= damage.Hull();
 	if(damage.Hull() && !isDisabled)
-		hullDelay = max(hullDelay, static_cast<int>(attributes.Get("repair delay")));
+		hullDelay = max(hullDelay, static_cast<int>(attributes.Get(REPAIR_DELAY)));
 
 	energy -= damage.Energy();
 	heat += damage.Heat();
@@ -3627,8 +3662,8 @@ int Ship::TakeDamage(vector<Visual> &visuals, const DamageDealt &damage, const G
 		ApplyForce(damage.HitForce(), damage.GetWeapon().IsGravitational());
 
 	// Prevent various stats from reaching unallowable values.
-	hull = min(hull, attributes.Get("hull"));
-	shields = min(shields, attributes.Get("shields"));
+	hull = min(hull, attributes.Get(HULL));
+	shields = min(shields, attributes.Get(SHIELDS));
 	// Weapons are allowed to overcharge a ship's energy or fuel, but code in Ship::DoGeneration()
 	// will clamp it to a maximum value at the beginning of the next frame.
 	energy = max(0., energy);
@@ -3644,7 +3679,7 @@ int Ship::TakeDamage(vector<Visual> &visuals, const DamageDealt &damage, const G
 	if(!wasDisabled && isDisabled)
 	{
 		type |= ShipEvent::DISABLE;
-		hullDelay = max(hullDelay, static_cast<int>(attributes.Get("disabled repair delay")));
+		hullDelay = max(hullDelay, static_cast<int>(attributes.Get(DISABLED_REPAIR_DELAY)));
 	}
 	if(!wasDestroyed && IsDestroyed())
 		type |= ShipEvent::DESTROY;
@@ -3898,7 +3933,7 @@ void Ship::Jettison(const string &commodity, int tons, bool wasAppeasing)
 	const Government *notForGov = wasAppeasing ? GetGovernment() : nullptr;
 
 	for( ; tons > 0; tons -= Flotsam::TONS_PER_BOX)
-		jettisoned.emplace_back(new Flotsam(commodity, (Flotsam::TONS_PER_BOX < tons)
+		jettisoned.push_back(Pool<Flotsam>::Make(commodity, (Flotsam::TONS_PER_BOX < tons)
 			? Flotsam::TONS_PER_BOX : tons, notForGov));
 }
 
@@ -3928,7 +3963,7 @@ void Ship::Jettison(const Outfit *outfit, int count, bool wasAppeasing)
 		? 1 : static_cast<int>(Flotsam::TONS_PER_BOX / mass);
 	while(count > 0)
 	{
-		jettisoned.emplace_back(new Flotsam(outfit, (perBox < count)
+		jettisoned.push_back(Pool<Flotsam>::Make(outfit, (perBox < count)
 			? perBox : count, notForGov));
 		count -= perBox;
 	}
@@ -3983,6 +4018,7 @@ void Ship::AddOutfit(const Outfit *outfit, int count)
 		}
 		int after = outfits.count(outfit);
 		attributes.Add(*outfit, count);
+		stats.Calibrate(*this);
 		if(outfit->IsWeapon())
 		{
 			armament.Add(outfit, count);
@@ -4044,13 +4080,13 @@ bool Ship::CanFire(const Weapon *weapon) const
 			return false;
 	}
 
-	if(energy < weapon->FiringEnergy() + weapon->RelativeFiringEnergy() * attributes.Get("energy capacity"))
+	if(energy < weapon->FiringEnergy() + weapon->RelativeFiringEnergy() * attributes.Get(ENERGY_CAPACITY))
 		return false;
-	if(fuel < weapon->FiringFuel() + weapon->RelativeFiringFuel() * attributes.Get("fuel capacity"))
+	if(fuel < weapon->FiringFuel() + weapon->RelativeFiringFuel() * attributes.Get(FUEL_CAPACITY))
 		return false;
 	// We do check hull, but we don't check shields. Ships can survive with all shields depleted.
 	// Ships should not disable themselves, so we check if we stay above minimumHull.
-	if(hull - MinimumHull() < weapon->FiringHull() + weapon->RelativeFiringHull() * attributes.Get("hull"))
+	if(hull - MinimumHull() < weapon->FiringHull() + weapon->RelativeFiringHull() * attributes.Get(HULL))
 		return false;
 
 	// If a weapon requires heat to fire, (rather than generating heat), we must
@@ -4078,11 +4114,11 @@ void Ship::ExpendAmmo(const Weapon &weapon)
 {
 	// Compute this ship's initial capacities, in case the consumption of the ammunition outfit(s)
 	// modifies them, so that relative costs are calculated based on the pre-firing state of the ship.
-	const double relativeEnergyChange = weapon.RelativeFiringEnergy() * attributes.Get("energy capacity");
-	const double relativeFuelChange = weapon.RelativeFiringFuel() * attributes.Get("fuel capacity");
+	const double relativeEnergyChange = weapon.RelativeFiringEnergy() * attributes.Get(ENERGY_CAPACITY);
+	const double relativeFuelChange = weapon.RelativeFiringFuel() * attributes.Get(FUEL_CAPACITY);
 	const double relativeHeatChange = !weapon.RelativeFiringHeat() ? 0. : weapon.RelativeFiringHeat() * MaximumHeat();
-	const double relativeHullChange = weapon.RelativeFiringHull() * attributes.Get("hull");
-	const double relativeShieldChange = weapon.RelativeFiringShields() * attributes.Get("shields");
+	const double relativeHullChange = weapon.RelativeFiringHull() * attributes.Get(HULL);
+	const double relativeShieldChange = weapon.RelativeFiringShields() * attributes.Get(SHIELDS);
 
 	if(const Outfit *ammo = weapon.Ammo())
 	{
@@ -4301,17 +4337,17 @@ double Ship::MinimumHull() const
 	if(neverDisabled)
 		return 0.;
 
-	double maximumHull = attributes.Get("hull");
-	double absoluteThreshold = attributes.Get("absolute threshold");
+	double maximumHull = attributes.Get(HULL);
+	double absoluteThreshold = attributes.Get(ABSOLUTE_THRESHOLD);
 	if(absoluteThreshold > 0.)
 		return absoluteThreshold;
 
-	double thresholdPercent = attributes.Get("threshold percentage");
+	double thresholdPercent = attributes.Get(THRESHOLD_PERCENTAGE);
 	double transition = 1 / (1 + 0.0005 * maximumHull);
 	double minimumHull = maximumHull * (thresholdPercent > 0.
 		? min(thresholdPercent, 1.) : 0.1 * (1. - transition) + 0.5 * transition);
 
-	return max(0., floor(minimumHull + attributes.Get("hull threshold")));
+	return max(0., floor(minimumHull + attributes.Get(HULL_THRESHOLD)));
 }
 
 
@@ -29,6 +29,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Point.h"
 #include "ship/ShipAICache.h"
 #include "ShipJumpNavigation.h"
+#include "ship/ShipStats.h"
 
 #include <list>
 #include <map>
@@ -547,6 +548,8 @@ private:
 
 	// Installed outfits, cargo, etc.:
 	Outfit attributes;
+	// Values derived from the attributes, updated whenever they change.
+	ShipStats stats;
 	Outfit baseAttributes;
 	bool addAttributes = false;
 	const Outfit *explosionWeapon = nullptr;
@@ -15,6 +15,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Sprite.h"
 
+#include "GameData.h"
 #include "ImageBuffer.h"
 #include "Preferences.h"
 #include "Screen.h"
@@ -26,6 +27,12 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 using namespace std;
 
+namespace {
+	// The number of frames that have begun, for keeping track of when each
+	// sprite that is loaded on demand was last drawn.
+	atomic<int> currentFrame(0);
+}
+
 
 
 Sprite::Sprite(const string &name)
@@ -43,19 +50,28 @@ const string &Sprite::Name() const
 
 
 // Upload the given frames. The given buffer will be cleared afterwards.
-void Sprite::AddFrames(ImageBuffer &buffer, bool is2x)
+// If uploading is disabled (e.g. because there is no OpenGL context), only
+// the sprite's dimensions are set.
+void Sprite::AddFrames(ImageBuffer &buffer, bool is2x, bool enableUpload)
 {
 	// Do nothing if the buffer is empty.
 	if(!buffer.Pixels())
 		return;
 
-	// If this is the 1x image, its dimensions determine the sprite's size.
-	if(!is2x)
+	// If this is the 1x image, its dimensions determine the sprite's size. A
+	// sprite that is loaded on demand already has its size, which other threads
+	// may be reading, so it is not set again.
+	if(!is2x && !isLoadedOnDemand)
 	{
 		width = buffer.Width();
 		height = buffer.Height();
 		frames = buffer.Frames();
 	}
+	if(!enableUpload)
+	{
+		buffer.Clear();
+		return;
+	}
 
 	// Check whether this sprite is large enough to require size reduction.
 	if(Preferences::Has("Reduce large graphics") && buffer.Width() * buffer.Height() >= 1000000)
@@ -78,6 +94,12 @@ void Sprite::AddFrames(ImageBuffer &buffer, bool is2x)
 
 	// Unbind the texture.
 	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	textureBytes += sizeof(uint32_t) * buffer.Width() * buffer.Height() * buffer.Frames();
+
+	// If this sprite is small enough, also copy it into an atlas so it can be
+	// drawn in the same batch as other sprites.
+	if(!atlas[is2x].texture && SpriteAtlas::Accepts(name, width, height, frames))
+		atlas[is2x] = SpriteAtlas::Add(buffer);
 
 	// Free the ImageBuffer memory.
 	buffer.Clear();
@@ -85,12 +107,19 @@ void Sprite::AddFrames(ImageBuffer &buffer, bool is2x)
 
 
 
-// Free up all textures loaded for this sprite.
+// Free up all textures loaded for this sprite. A sprite that is loaded on
+// demand keeps its dimensions, and will be loaded again once it is drawn.
 void Sprite::Unload()
 {
 	glDeleteTextures(2, texture);
 	texture[0] = texture[1] = 0;
+	textureBytes = 0;
 
+	if(isLoadedOnDemand)
+	{
+		isRequested = false;
+		return;
+	}
 	width = 0.f;
 	height = 0.f;
 	frames = 0;
@@ -98,6 +127,50 @@ void Sprite::Unload()
 
 
 
+// Give this sprite its dimensions without loading any frames. Its frames
+// will instead be loaded the first time that it is drawn.
+void Sprite::LoadOnDemand(float width, float height, int frames)
+{
+	this->width = width;
+	this->height = height;
+	this->frames = frames;
+	isLoadedOnDemand = true;
+}
+
+
+
+bool Sprite::IsLoadedOnDemand() const
+{
+	return isLoadedOnDemand;
+}
+
+
+
+// Get the number of bytes of texture memory this sprite is using.
+size_t Sprite::TextureBytes() const
+{
+	return textureBytes;
+}
+
+
+
+// Get how many frames it has been since this sprite was last drawn. Only
+// sprites that are loaded on demand keep track of this.
+int Sprite::FramesSinceDrawn() const
+{
+	return currentFrame - lastDrawn;
+}
+
+
+
+// Begin a new frame, for the purpose of tracking when sprites were drawn.
+void Sprite::NextFrame()
+{
+	++currentFrame;
+}
+
+
+
 // Get the width, in pixels, of the 1x image.
 float Sprite::Width() const
 {
@@ -142,5 +215,27 @@ uint32_t Sprite::Texture() const
 // Get the index of the texture for the given high DPI mode.
 uint32_t Sprite::Texture(bool isHighDPI) const
 {
+	if(isLoadedOnDemand)
+		MarkDrawn();
 	return (isHighDPI && texture[1]) ? texture[1] : texture[0];
 }
+
+
+
+// Get where this sprite is in the shared atlas textures, for the given high
+// DPI mode. If it is not in an atlas, the region has no texture.
+const SpriteAtlas::Region &Sprite::AtlasRegion(bool isHighDPI) const
+{
+	return (isHighDPI && atlas[1].texture) ? atlas[1] : atlas[0];
+}
+
+
+
+// Note that this sprite is being drawn, and ask for its frames to be loaded
+// if they are not already.
+void Sprite::MarkDrawn() const
+{
+	lastDrawn = currentFrame.load();
+	if(!isRequested.exchange(true))
+		GameData::Preload(this);
+}
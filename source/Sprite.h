@@ -17,7 +17,10 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #define SPRITE_H_
 
 #include "Point.h"
+#include "SpriteAtlas.h"
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -32,14 +35,31 @@ class ImageBuffer;
 class Sprite {
 public:
 	explicit Sprite(const std::string &name = "");
+	Sprite(const Sprite &) = delete;
+	Sprite &operator=(const Sprite &) = delete;
 
 	const std::string &Name() const;
 
 	// Upload the given frames. The given buffer will be cleared afterwards.
-	void AddFrames(ImageBuffer &buffer, bool is2x);
-	// Free up all textures loaded for this sprite.
+	// If uploading is disabled (e.g. because there is no OpenGL context), only
+	// the sprite's dimensions are set.
+	void AddFrames(ImageBuffer &buffer, bool is2x, bool enableUpload);
+	// Free up all textures loaded for this sprite. A sprite that is loaded on
+	// demand keeps its dimensions, and will be loaded again once it is drawn.
 	void Unload();
 
+	// Give this sprite its dimensions without loading any frames. Its frames
+	// will instead be loaded the first time that it is drawn.
+	void LoadOnDemand(float width, float height, int frames);
+	bool IsLoadedOnDemand() const;
+	// Get the number of bytes of texture memory this sprite is using.
+	std::size_t TextureBytes() const;
+	// Get how many frames it has been since this sprite was last drawn. Only
+	// sprites that are loaded on demand keep track of this.
+	int FramesSinceDrawn() const;
+	// Begin a new frame, for the purpose of tracking when sprites were drawn.
+	static void NextFrame();
+
 	// Image dimensions, in pixels.
 	float Width() const;
 	float Height() const;
@@ -55,12 +75,34 @@ public:
 	// setting or specifying it manually.
 	uint32_t Texture() const;
 	uint32_t Texture(bool isHighDPI) const;
+	// Get where this sprite is in the shared atlas textures, for the given high
+	// DPI mode. If it is not in an atlas, the region has no texture.
+	const SpriteAtlas::Region &AtlasRegion(bool isHighDPI) const;
+
+
+private:
+	// Note that this sprite is being drawn, and ask for its frames to be loaded
+	// if they are not already.
+	void MarkDrawn() const;
 
 
 private:
 	std::string name;
 
+	// The textures are only loaded, unloaded, and looked up on the main thread.
+	// Other threads may add sprites to a list to be drawn, but the list does not
+	// look up their textures until the main thread draws it.
 	uint32_t texture[2] = {0, 0};
+	std::size_t textureBytes = 0;
+	// Small sprites are also copied into an atlas. They keep their place in it
+	// even if they are unloaded.
+	SpriteAtlas::Region atlas[2];
+
+	// Whether this sprite has asked to be loaded, and when it was last drawn.
+	// These are atomic so that sprites can safely be drawn from any thread.
+	bool isLoadedOnDemand = false;
+	mutable std::atomic<bool> isRequested{false};
+	mutable std::atomic<int> lastDrawn{0};
 
 	float width = 0.f;
 	float height = 0.f;
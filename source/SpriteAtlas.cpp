@@ -0,0 +1,204 @@
+/* SpriteAtlas.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "SpriteAtlas.h"
+
+#include "ImageBuffer.h"
+
+#include "opengl.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// Every atlas texture is a square of this size, which every OpenGL ES 3
+	// implementation supports.
+	const int ATLAS_SIZE = 2048;
+	// The largest 1x sprites that are packed, and the widest row of frames.
+	const int MAX_SIZE = 128;
+	const int MAX_ROW = 512;
+	// A border is left around each frame, so that linear filtering never blends
+	// in the edge of a neighboring frame or sprite. The border repeats the
+	// frame's edge pixels, so the edges are filtered the same way as in the
+	// sprite's own texture, which clamps to its edges.
+	const int PADDING = 1;
+
+	// Each atlas is filled with "shelves," rows that each hold sprites of up
+	// to a certain height placed side by side.
+	class Shelf {
+	public:
+		int y;
+		int height;
+		int x;
+	};
+
+	class Atlas {
+	public:
+		uint32_t texture = 0;
+		vector<Shelf> shelves;
+		// The top of the space that no shelf has been placed in yet.
+		int nextY = 0;
+	};
+
+	vector<Atlas> atlases;
+
+
+	// Find space for a rectangle of the given size in the given atlas.
+	bool Place(Atlas &atlas, int width, int height, int &x, int &y)
+	{
+		// Use the shortest shelf that the rectangle fits in, to waste as little
+		// space as possible.
+		Shelf *best = nullptr;
+		for(Shelf &shelf : atlas.shelves)
+			if(shelf.height >= height && ATLAS_SIZE - shelf.x >= width && (!best || shelf.height < best->height))
+				best = &shelf;
+
+		// If no shelf has room, start a new one.
+		if(!best || best->height > 2 * height)
+		{
+			if(ATLAS_SIZE - atlas.nextY < height)
+			{
+				if(!best)
+					return false;
+			}
+			else
+			{
+				atlas.shelves.push_back(Shelf{atlas.nextY, height, 0});
+				atlas.nextY += height;
+				best = &atlas.shelves.back();
+			}
+		}
+
+		x = best->x;
+		y = best->y;
+		best->x += width;
+		return true;
+	}
+
+
+	// Create a new, empty atlas texture.
+	Atlas &NewAtlas()
+	{
+		atlases.emplace_back();
+		Atlas &atlas = atlases.back();
+
+		glGenTextures(1, &atlas.texture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, atlas.texture);
+		// Use the same settings as for each sprite's own texture.
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		// Only the parts of the texture that sprites are copied into are ever
+		// drawn, so there is no need to initialize the rest of it.
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, ATLAS_SIZE, ATLAS_SIZE, 1,
+			0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		return atlas;
+	}
+}
+
+
+
+// Check whether the sprite with the given name and 1x dimensions should be
+// packed into an atlas. Only small sprites that are drawn in batches are.
+bool SpriteAtlas::Accepts(const string &name, int width, int height, int frames)
+{
+	bool isBatched = !name.compare(0, 7, "effect/") || !name.compare(0, 11, "projectile/");
+	return isBatched && width > 0 && height > 0 && width <= MAX_SIZE && height <= MAX_SIZE
+		&& frames * (width + 2 * PADDING) <= MAX_ROW;
+}
+
+
+
+// Copy all the frames in the given buffer into an atlas. This must be called
+// from the main thread. If there is no room, the region has no texture.
+SpriteAtlas::Region SpriteAtlas::Add(const ImageBuffer &buffer)
+{
+	Region region;
+	int width = buffer.Width();
+	int height = buffer.Height();
+	int frames = buffer.Frames();
+	if(!buffer.Pixels() || width <= 0 || height <= 0 || frames <= 0)
+		return region;
+
+	// Frames are placed side by side, each with its own padding.
+	int frameWidth = width + 2 * PADDING;
+	int rowWidth = frames * frameWidth;
+	int rowHeight = height + 2 * PADDING;
+	if(rowWidth > ATLAS_SIZE || rowHeight > ATLAS_SIZE)
+		return region;
+
+	// Use the first atlas with room for this sprite, or start a new one.
+	int x = 0;
+	int y = 0;
+	Atlas *atlas = nullptr;
+	for(Atlas &it : atlases)
+		if(Place(it, rowWidth, rowHeight, x, y))
+		{
+			atlas = &it;
+			break;
+		}
+	if(!atlas)
+	{
+		atlas = &NewAtlas();
+		if(!Place(*atlas, rowWidth, rowHeight, x, y))
+			return region;
+	}
+
+	// Copy the frames into a single image with the padding already in place,
+	// so that they can be uploaded all at once.
+	vector<uint32_t> row(static_cast<size_t>(rowWidth) * rowHeight, 0);
+	for(int frame = 0; frame < frames; ++frame)
+	{
+		for(int line = 0; line < height; ++line)
+		{
+			uint32_t *out = &row[static_cast<size_t>(line + PADDING) * rowWidth + frame * frameWidth + PADDING];
+			memcpy(out, buffer.Begin(line, frame), width * sizeof(uint32_t));
+			// Extend the left and right edges into the padding.
+			for(int i = 1; i <= PADDING; ++i)
+			{
+				out[-i] = out[0];
+				out[width - 1 + i] = out[width - 1];
+			}
+		}
+		// Then extend the top and bottom edges, including the corners.
+		uint32_t *column = &row[frame * frameWidth];
+		for(int i = 0; i < PADDING; ++i)
+		{
+			memcpy(column + static_cast<size_t>(i) * rowWidth,
+				column + static_cast<size_t>(PADDING) * rowWidth, frameWidth * sizeof(uint32_t));
+			memcpy(column + static_cast<size_t>(rowHeight - 1 - i) * rowWidth,
+				column + static_cast<size_t>(rowHeight - 1 - PADDING) * rowWidth, frameWidth * sizeof(uint32_t));
+		}
+	}
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, atlas->texture);
+	glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, 0, rowWidth, rowHeight, 1,
+		GL_RGBA, GL_UNSIGNED_BYTE, row.data());
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	const float scale = 1.f / ATLAS_SIZE;
+	region.texture = atlas->texture;
+	region.left = (x + PADDING) * scale;
+	region.top = (y + PADDING) * scale;
+	region.width = width * scale;
+	region.height = height * scale;
+	region.step = frameWidth * scale;
+	return region;
+}
@@ -0,0 +1,59 @@
+/* SpriteAtlas.h
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPRITE_ATLAS_H_
+#define SPRITE_ATLAS_H_
+
+#include <cstdint>
+#include <string>
+
+class ImageBuffer;
+
+
+
+// This class is a collection of global functions for packing small sprites
+// into a few large shared textures, so that BatchDrawList can draw many
+// different sprites with a single draw call. All of a sprite's frames are
+// placed side by side in a single layer of an atlas texture. Sprites that are
+// packed into an atlas still have their own textures too, for everything else
+// that draws them. Space in an atlas is never freed, so a sprite keeps its
+// place even if it is unloaded and loaded again.
+class SpriteAtlas {
+public:
+	// Where in an atlas texture a sprite's first frame is, in texture
+	// coordinates, and how far apart its frames are.
+	class Region {
+	public:
+		uint32_t texture = 0;
+		float left = 0.f;
+		float top = 0.f;
+		float width = 0.f;
+		float height = 0.f;
+		float step = 0.f;
+	};
+
+
+public:
+	// Check whether the sprite with the given name and 1x dimensions should be
+	// packed into an atlas. Only small sprites that are drawn in batches are.
+	static bool Accepts(const std::string &name, int width, int height, int frames);
+	// Copy all the frames in the given buffer into an atlas. This must be called
+	// from the main thread. If there is no room, the region has no texture.
+	static Region Add(const ImageBuffer &buffer);
+};
+
+
+
+#endif
@@ -23,9 +23,16 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <algorithm>
 #include <functional>
+#include <utility>
 
 using namespace std;
 
+namespace {
+	// Sprites that were drawn this recently are never unloaded, even if that
+	// means going over the budget, because they are likely still on screen.
+	const int MIN_UNUSED_FRAMES = 120;
+}
+
 
 
 // Constructor, which allocates worker threads.
@@ -58,8 +65,8 @@ SpriteQueue::~SpriteQueue()
 
 
 
-// Add a sprite to load.
-void SpriteQueue::Add(const shared_ptr<ImageSet> &images)
+// Add a sprite to load. Urgent sprites are loaded before any others.
+void SpriteQueue::Add(const shared_ptr<ImageSet> &images, bool isUrgent)
 {
 	{
 #ifndef ES_NO_THREADS
@@ -69,7 +76,13 @@ void SpriteQueue::Add(const shared_ptr<ImageSet> &images)
 		if(added < 0)
 			return;
 
-		toRead.push(images);
+		if(isUrgent)
+		{
+			urgentToRead.push(images);
+			++urgentAdded;
+		}
+		else
+			toRead.push_back(images);
 		++added;
 	}
 #ifndef ES_NO_THREADS
@@ -81,6 +94,35 @@ void SpriteQueue::Add(const shared_ptr<ImageSet> &images)
 
 
 
+// If the sprite with the given name has not started loading yet, make it
+// urgent, so it is loaded before any sprites that are not.
+void SpriteQueue::Prioritize(const string &name)
+{
+#ifndef ES_NO_THREADS
+	lock_guard<mutex> lock(readMutex);
+#endif // ES_NO_THREADS
+	auto it = find_if(toRead.begin(), toRead.end(),
+		[&name](const shared_ptr<ImageSet> &images) { return images->Name() == name; });
+	if(it == toRead.end())
+		return;
+
+	urgentToRead.push(*it);
+	toRead.erase(it);
+	++urgentAdded;
+}
+
+
+
+// Set up a sprite to be loaded once it is first drawn, instead of now. The
+// images should be added once that happens. Return false if this sprite
+// cannot be loaded on demand and should be added right away instead.
+bool SpriteQueue::LoadOnDemand(const shared_ptr<ImageSet> &images)
+{
+	return images->LoadOnDemand(SpriteSet::Modify(images->Name()));
+}
+
+
+
 // Unload the texture for the given sprite (to free up memory).
 void SpriteQueue::Unload(const string &name)
 {
@@ -92,6 +134,25 @@ void SpriteQueue::Unload(const string &name)
 
 
 
+// Load sprites without uploading them to the GPU, e.g. because no OpenGL
+// context exists. Sprite dimensions and collision masks are still set.
+void SpriteQueue::DisableUpload()
+{
+	enableUpload = false;
+}
+
+
+
+// Set how many bytes of texture memory the sprites that are loaded on
+// demand may use. Once they use more than that, the ones that have gone
+// the longest without being drawn are unloaded. Zero means no limit.
+void SpriteQueue::SetBudget(size_t bytes)
+{
+	budget = bytes;
+}
+
+
+
 // Determine the fraction of sprites uploaded to the GPU.
 double SpriteQueue::GetProgress() const
 {
@@ -108,14 +169,31 @@ double SpriteQueue::GetProgress() const
 
 
 
+// Determine the fraction of urgent sprites uploaded to the GPU.
+double SpriteQueue::GetUrgentProgress() const
+{
+#ifndef ES_NO_THREADS
+	unique_lock<mutex> readLock(readMutex);
+#endif // ES_NO_THREADS
+	if(added < 0 || urgentAdded == urgentCompleted)
+		return 1.;
+	return static_cast<double>(urgentCompleted) / static_cast<double>(urgentAdded);
+}
+
+
+
 void SpriteQueue::UploadSprites()
 {
+	{
 #ifndef ES_NO_THREADS
-	unique_lock<mutex> lock(loadMutex);
-	DoLoad(lock);
+		unique_lock<mutex> lock(loadMutex);
+		DoLoad(lock);
 #else
-	DoLoad();
+		DoLoad();
 #endif // ES_NO_THREADS
+	}
+	// Now that any new sprites have been uploaded, make room for them.
+	Evict();
 }
 
 
@@ -156,12 +234,22 @@ void SpriteQueue::operator()()
 			// "added" to -1.
 			if(added < 0)
 				return;
-			if(toRead.empty())
+			if(urgentToRead.empty() && toRead.empty())
 				break;
 
 			// Extract the one item we should work on reading right now.
-			shared_ptr<ImageSet> imageSet = toRead.front();
-			toRead.pop();
+			bool isUrgent = !urgentToRead.empty();
+			shared_ptr<ImageSet> imageSet;
+			if(isUrgent)
+			{
+				imageSet = urgentToRead.front();
+				urgentToRead.pop();
+			}
+			else
+			{
+				imageSet = toRead.front();
+				toRead.pop_front();
+			}
 
 			// It's now safe to add to the lists.
 			lock.unlock();
@@ -174,7 +262,7 @@ void SpriteQueue::operator()()
 			{
 				// The texture must be uploaded to OpenGL in the main thread.
 				unique_lock<mutex> lock(loadMutex);
-				toLoad.push(imageSet);
+				toLoad.emplace(imageSet, isUrgent);
 			}
 			loadCondition.notify_one();
 
@@ -188,14 +276,24 @@ void SpriteQueue::operator()()
 	// "added" to -1.
 	if(added < 0)
 		return;
-	if(toRead.empty())
+	if(urgentToRead.empty() && toRead.empty())
 		return;
 
 	// Extract the one item we should work on reading right now.
-	shared_ptr<ImageSet> imageSet = toRead.front();
-	toRead.pop();
+	bool isUrgent = !urgentToRead.empty();
+	shared_ptr<ImageSet> imageSet;
+	if(isUrgent)
+	{
+		imageSet = urgentToRead.front();
+		urgentToRead.pop();
+	}
+	else
+	{
+		imageSet = toRead.front();
+		toRead.pop_front();
+	}
 	imageSet->Load();
-	toLoad.push(imageSet);
+	toLoad.emplace(imageSet, isUrgent);
 #endif // ES_NO_THREADS
 }
 
@@ -221,16 +319,24 @@ void SpriteQueue::DoLoad()
 	for(int i = 0; !toLoad.empty() && i < 100; ++i)
 	{
 		// Extract the one item we should work on uploading right now.
-		shared_ptr<ImageSet> imageSet = toLoad.front();
+		shared_ptr<ImageSet> imageSet = toLoad.front().first;
+		bool isUrgent = toLoad.front().second;
 		toLoad.pop();
 
 		// It's now safe to modify the lists.
 		lock.unlock();
 
-		imageSet->Upload(SpriteSet::Modify(imageSet->Name()));
+		Sprite *sprite = SpriteSet::Modify(imageSet->Name());
+		imageSet->Upload(sprite, enableUpload);
+		if(sprite->IsLoadedOnDemand())
+		{
+			onDemand.push_back(sprite);
+			onDemandBytes += sprite->TextureBytes();
+		}
 
 		lock.lock();
 		++completed;
+		urgentCompleted += isUrgent;
 	}
 #else
 	while(!toUnload.empty())
@@ -243,12 +349,50 @@ void SpriteQueue::DoLoad()
 	for(int i = 0; !toLoad.empty() && i < 100; ++i)
 	{
 		// Extract the one item we should work on uploading right now.
-		shared_ptr<ImageSet> imageSet = toLoad.front();
+		shared_ptr<ImageSet> imageSet = toLoad.front().first;
+		bool isUrgent = toLoad.front().second;
 		toLoad.pop();
 
-		imageSet->Upload(SpriteSet::Modify(imageSet->Name()));
+		Sprite *sprite = SpriteSet::Modify(imageSet->Name());
+		imageSet->Upload(sprite, enableUpload);
+		if(sprite->IsLoadedOnDemand())
+		{
+			onDemand.push_back(sprite);
+			onDemandBytes += sprite->TextureBytes();
+		}
 
 		++completed;
+		urgentCompleted += isUrgent;
 	}
 #endif // ES_NO_THREADS
 }
+
+
+
+// Unload sprites that are loaded on demand until they fit in the budget.
+void SpriteQueue::Evict()
+{
+	if(!budget || onDemandBytes <= budget)
+		return;
+
+	// Put the sprites that have gone the longest without being drawn last. How
+	// long ago each one was drawn is copied first, because it is atomic and so
+	// is not free to read in every comparison.
+	vector<pair<int, Sprite *>> byAge;
+	byAge.reserve(onDemand.size());
+	for(Sprite *sprite : onDemand)
+		byAge.emplace_back(sprite->FramesSinceDrawn(), sprite);
+	sort(byAge.begin(), byAge.end());
+
+	while(onDemandBytes > budget && !byAge.empty() && byAge.back().first >= MIN_UNUSED_FRAMES)
+	{
+		Sprite *sprite = byAge.back().second;
+		onDemandBytes -= sprite->TextureBytes();
+		sprite->Unload();
+		byAge.pop_back();
+	}
+
+	onDemand.clear();
+	for(const auto &it : byAge)
+		onDemand.push_back(it.second);
+}
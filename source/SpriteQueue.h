@@ -17,12 +17,15 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #define SPRITE_QUEUE_H_
 
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 class ImageBuffer;
@@ -45,12 +48,28 @@ public:
 	SpriteQueue &operator=(const SpriteQueue &other) = delete;
 	SpriteQueue &operator=(SpriteQueue &&other) = delete;
 
-	// Add a sprite to load.
-	void Add(const std::shared_ptr<ImageSet> &images);
+	// Add a sprite to load. Urgent sprites are loaded before any others.
+	void Add(const std::shared_ptr<ImageSet> &images, bool isUrgent = false);
+	// If the sprite with the given name has not started loading yet, make it
+	// urgent, so it is loaded before any sprites that are not.
+	void Prioritize(const std::string &name);
+	// Set up a sprite to be loaded once it is first drawn, instead of now. The
+	// images should be added once that happens. Return false if this sprite
+	// cannot be loaded on demand and should be added right away instead.
+	bool LoadOnDemand(const std::shared_ptr<ImageSet> &images);
 	// Unload the texture for the given sprite (to free up memory).
 	void Unload(const std::string &name);
+	// Load sprites without uploading them to the GPU, e.g. because no OpenGL
+	// context exists. Sprite dimensions and collision masks are still set.
+	void DisableUpload();
+	// Set how many bytes of texture memory the sprites that are loaded on
+	// demand may use. Once they use more than that, the ones that have gone
+	// the longest without being drawn are unloaded. Zero means no limit.
+	void SetBudget(std::size_t bytes);
 	// Determine the fraction of sprites uploaded to the GPU.
 	double GetProgress() const;
+	// Determine the fraction of urgent sprites uploaded to the GPU.
+	double GetUrgentProgress() const;
 	// Uploads any available sprites to the GPU.
 	void UploadSprites();
 	// Finish loading.
@@ -66,27 +85,43 @@ private:
 #else
 	void DoLoad();
 #endif // ES_NO_THREADS
+	// Unload sprites that are loaded on demand until they fit in the budget.
+	void Evict();
 
 
 private:
-	// These are the image sets that need to be loaded from disk.
-	std::queue<std::shared_ptr<ImageSet>> toRead;
+	// These are the image sets that need to be loaded from disk. The urgent
+	// ones are all read before any of the others.
+	std::queue<std::shared_ptr<ImageSet>> urgentToRead;
+	std::deque<std::shared_ptr<ImageSet>> toRead;
 #ifndef ES_NO_THREADS
 	mutable std::mutex readMutex;
 	std::condition_variable readCondition;
 #endif // ES_NO_THREADS
 	int added = 0;
+	int urgentAdded = 0;
 
-	// These image sets have been loaded from disk but have not been uploaded.
-	std::queue<std::shared_ptr<ImageSet>> toLoad;
+	// These image sets have been loaded from disk but have not been uploaded,
+	// along with whether each one is urgent.
+	std::queue<std::pair<std::shared_ptr<ImageSet>, bool>> toLoad;
 #ifndef ES_NO_THREADS
 	std::mutex loadMutex;
 	std::condition_variable loadCondition;
 #endif // ES_NO_THREADS
 	int completed = 0;
+	int urgentCompleted = 0;
 
 	// These sprites must be unloaded to reclaim GPU memory.
 	std::queue<std::string> toUnload;
+	// Whether loaded sprites should be uploaded to the GPU.
+	bool enableUpload = true;
+
+	// The sprites loaded on demand that are currently uploaded, and how much
+	// texture memory they may use in total. These are only used by the main
+	// thread, so they need no mutex.
+	std::vector<Sprite *> onDemand;
+	std::size_t onDemandBytes = 0;
+	std::size_t budget = 0;
 
 	// Worker threads for loading sprites from disk.
 	std::vector<std::thread> threads;
@@ -30,6 +30,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 using namespace std;
 
@@ -45,6 +46,7 @@ namespace {
 }
 
 const double System::DEFAULT_NEIGHBOR_DISTANCE = 100.;
+const unsigned System::NO_INDEX = numeric_limits<unsigned>::max();
 
 
 
@@ -574,6 +576,24 @@ const Point &System::Position() const
 
 
 
+// Get this system's index. All systems that have been updated are numbered
+// from zero without gaps, so the index can be used to look up per-system
+// data in a flat array. Systems created since then have NO_INDEX. A system's
+// index never changes once it is given, so new systems are numbered last.
+unsigned System::Index() const
+{
+	return index;
+}
+
+
+
+void System::SetIndex(unsigned index)
+{
+	this->index = index;
+}
+
+
+
 // Get this system's government.
 const Government *System::GetGovernment() const
 {
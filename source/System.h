@@ -45,6 +45,8 @@ class Sprite;
 class System {
 public:
 	static const double DEFAULT_NEIGHBOR_DISTANCE;
+	// The index of a system that has not been given one yet.
+	static const unsigned NO_INDEX;
 
 public:
 	class Asteroid {
@@ -81,6 +83,12 @@ public:
 	const std::string &Name() const;
 	void SetName(const std::string &name);
 	const Point &Position() const;
+	// Get this system's index. All systems that have been updated are numbered
+	// from zero without gaps, so the index can be used to look up per-system
+	// data in a flat array. Systems created since then have NO_INDEX. A system's
+	// index never changes once it is given, so new systems are numbered last.
+	unsigned Index() const;
+	void SetIndex(unsigned index);
 	// Get this system's government.
 	const Government *GetGovernment() const;
 	// Get the name of the ambient audio to play in this system.
@@ -202,6 +210,7 @@ private:
 	// Name and position (within the star map) of this system.
 	std::string name;
 	Point position;
+	unsigned index = NO_INDEX;
 	const Government *government = nullptr;
 	std::string music;
 
@@ -31,6 +31,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "SpriteQueue.h"
 #include "SpriteSet.h"
 #include "StarField.h"
+#include "WorkerPool.h"
 
 #include <algorithm>
 #include <iterator>
@@ -68,6 +69,18 @@ namespace {
 		it.second.SetName(it.first);
 		Warn(noun, it.first);
 	}
+
+	// Only text files hold game data. Anything else (e.g. an image) is skipped.
+	bool IsDataFile(const string &path)
+	{
+		return path.length() >= 4 && !path.compare(path.length() - 4, 4, ".txt");
+	}
+
+#ifndef ES_NO_THREADS
+	// The number of data files that are parsed at once. Parsing a file does not
+	// depend on any other file, so each batch is spread across the worker pool.
+	const size_t LOAD_BATCH = 64;
+#endif // ES_NO_THREADS
 }
 
 
@@ -96,14 +109,33 @@ future<void> UniverseObjects::Load(const vector<string> &sources, bool debugMode
 			}
 
 			const double step = 1. / (static_cast<int>(files.size()) + 1);
-			for(const auto &path : files)
+			for(size_t begin = 0; begin < files.size(); begin += LOAD_BATCH)
 			{
-				LoadFile(path, debugMode);
-
-				// Increment the atomic progress by one step.
-				// We use acquire + release to prevent any reordering.
-				auto val = progress.load(memory_order_acquire);
-				progress.store(val + step, memory_order_release);
+				// Parse a batch of files in parallel, then load the objects that
+				// they define one file at a time, in the same order as before, so
+				// that definitions in later files still override earlier ones.
+				// Warnings from parsing are also printed in that order.
+				const size_t count = min(LOAD_BATCH, files.size() - begin);
+				vector<DataFile> batch(count);
+				WorkerPool::Run(count, [&files, &batch, begin](size_t i) -> void
+					{
+						if(IsDataFile(files[begin + i]))
+							batch[i].Load(files[begin + i], true, true);
+					});
+
+				for(size_t i = 0; i < count; ++i)
+				{
+					if(IsDataFile(files[begin + i]))
+					{
+						batch[i].PrintWarnings();
+						LoadFile(batch[i], files[begin + i], debugMode);
+					}
+
+					// Increment the atomic progress by one step.
+					// We use acquire + release to prevent any reordering.
+					auto val = progress.load(memory_order_acquire);
+					progress.store(val + step, memory_order_release);
+				}
 			}
 			FinishLoading();
 			progress = 1.;
@@ -130,7 +162,12 @@ void UniverseObjects::Load(const vector<string> &sources, bool debugMode)
 	const double step = 1. / (static_cast<int>(files.size()) + 1);
 	for(const auto &path : files)
 	{
-		LoadFile(path, debugMode);
+		if(IsDataFile(path))
+		{
+			DataFile data;
+			data.Load(path, true);
+			LoadFile(data, path, debugMode);
+		}
 		progress = progress + step;
 	}
 	FinishLoading();
@@ -240,11 +277,20 @@ void UniverseObjects::Change(const DataNode &node)
 // (This must be done any time a GameEvent creates or moves a system.)
 void UniverseObjects::UpdateSystems()
 {
+	// Systems keep the index they were first given, because cached distance
+	// maps may still refer to them by it. New systems are numbered after them.
+	unsigned nextIndex = 0;
+	for(const auto &it : systems)
+		if(it.second.Index() != System::NO_INDEX)
+			nextIndex = max(nextIndex, it.second.Index() + 1);
+
 	for(auto &it : systems)
 	{
 		// Skip systems that have no name.
 		if(it.first.empty() || it.second.Name().empty())
 			continue;
+		if(it.second.Index() == System::NO_INDEX)
+			it.second.SetIndex(nextIndex++);
 		it.second.UpdateSystem(systems, neighborDistances);
 
 		// If there were changes to a system there might have been a change to a legacy
@@ -366,13 +412,8 @@ void UniverseObjects::CheckReferences()
 
 
 
-void UniverseObjects::LoadFile(const string &path, bool debugMode)
+void UniverseObjects::LoadFile(const DataFile &data, const string &path, bool debugMode)
 {
-	// This is an ordinary file. Check to see if it is an image.
-	if(path.length() < 4 || path.compare(path.length() - 4, 4, ".txt"))
-		return;
-
-	DataFile data(path);
 	if(debugMode)
 		Logger::LogError("Parsing: " + path);
 
@@ -55,6 +55,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <vector>
 
 
+class DataFile;
 class Panel;
 class Sprite;
 
@@ -93,7 +94,8 @@ public:
 
 
 private:
-	void LoadFile(const std::string &path, bool debugMode = false);
+	// Load the objects defined in the given data file, which was read from the given path.
+	void LoadFile(const DataFile &data, const std::string &path, bool debugMode = false);
 
 
 private:
@@ -0,0 +1,229 @@
+/* WorkerPool.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+#ifndef ES_NO_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif // ES_NO_THREADS
+
+using namespace std;
+
+namespace {
+	void RunSerial(size_t count, const function<void(size_t)> &function)
+	{
+		for(size_t i = 0; i < count; ++i)
+			function(i);
+	}
+
+#ifndef ES_NO_THREADS
+	// Each thread claims this many chunks of the work, on average. Handing out
+	// the work in chunks keeps the threads from all contending for the same
+	// counter, while still balancing out tasks that take longer than others.
+	const size_t CHUNKS_PER_THREAD = 4;
+
+	class Pool {
+	public:
+		Pool();
+		~Pool();
+
+		size_t Threads() const;
+		void Run(size_t count, const function<void(size_t)> &function);
+
+
+	private:
+		// Thread entry point.
+		void Work();
+		// Run tasks until none are left.
+		void Process();
+
+
+	private:
+		// Only one batch of work can be in progress at a time.
+		mutex runMutex;
+
+		// This mutex guards everything below except for "next".
+		mutex workMutex;
+		condition_variable wakeCondition;
+		condition_variable doneCondition;
+		// The batch number changes each time new work is handed out.
+		uint64_t batch = 0;
+		// The number of worker threads that have not finished the current batch.
+		size_t busy = 0;
+		bool quit = false;
+
+		const function<void(size_t)> *task = nullptr;
+		size_t count = 0;
+		size_t chunk = 1;
+		atomic<size_t> next;
+
+		size_t threadCount = 1;
+		vector<thread> threads;
+	};
+
+
+
+	Pool::Pool()
+		: next(0)
+	{
+		threadCount = max(1u, thread::hardware_concurrency());
+	}
+
+
+
+	// Wait for all worker threads to wrap up.
+	Pool::~Pool()
+	{
+		{
+			lock_guard<mutex> lock(workMutex);
+			quit = true;
+		}
+		wakeCondition.notify_all();
+		for(thread &t : threads)
+			t.join();
+	}
+
+
+
+	size_t Pool::Threads() const
+	{
+		return threadCount;
+	}
+
+
+
+	void Pool::Run(size_t count, const function<void(size_t)> &function)
+	{
+		// If another batch is already running, this must either be a task that
+		// is asking for more work to be done or a second thread using the pool.
+		// Waiting for the pool to be free could deadlock in the first case.
+		unique_lock<mutex> runLock(runMutex, try_to_lock);
+		if(!runLock.owns_lock())
+		{
+			RunSerial(count, function);
+			return;
+		}
+
+		{
+			lock_guard<mutex> lock(workMutex);
+			// The worker threads are not created until they are first needed.
+			if(threads.empty())
+			{
+				threads.resize(threadCount - 1);
+				for(thread &t : threads)
+					t = thread(&Pool::Work, this);
+			}
+
+			task = &function;
+			this->count = count;
+			chunk = max<size_t>(1, count / (threadCount * CHUNKS_PER_THREAD));
+			next = 0;
+			busy = threads.size();
+			++batch;
+		}
+		wakeCondition.notify_all();
+
+		// The calling thread helps out instead of sitting idle.
+		Process();
+
+		// Wait until every worker thread is done with this batch, so that the
+		// function can no longer be called once this returns.
+		unique_lock<mutex> lock(workMutex);
+		doneCondition.wait(lock, [this] { return !busy; });
+		task = nullptr;
+	}
+
+
+
+	void Pool::Work()
+	{
+		uint64_t lastBatch = 0;
+		unique_lock<mutex> lock(workMutex);
+		while(true)
+		{
+			wakeCondition.wait(lock, [this, lastBatch] { return quit || batch != lastBatch; });
+			if(quit)
+				return;
+			lastBatch = batch;
+
+			lock.unlock();
+			Process();
+			lock.lock();
+
+			if(!--busy)
+				doneCondition.notify_one();
+		}
+	}
+
+
+
+	void Pool::Process()
+	{
+		while(true)
+		{
+			size_t begin = next.fetch_add(chunk);
+			if(begin >= count)
+				return;
+			size_t end = min(count, begin + chunk);
+			for(size_t i = begin; i < end; ++i)
+				(*task)(i);
+		}
+	}
+
+
+
+	Pool &GetPool()
+	{
+		static Pool pool;
+		return pool;
+	}
+#endif // ES_NO_THREADS
+}
+
+
+
+// Call the given function once for every index from 0 to count - 1. The
+// calls may happen in any order and on any thread, so the function must
+// only modify data that belongs to the index that it is given.
+void WorkerPool::Run(size_t count, const function<void(size_t)> &function)
+{
+#ifndef ES_NO_THREADS
+	Pool &pool = GetPool();
+	if(count > 1 && pool.Threads() > 1)
+		pool.Run(count, function);
+	else
+#endif // ES_NO_THREADS
+		RunSerial(count, function);
+}
+
+
+
+// Get the number of threads, including the calling thread, that may
+// take part in running the work.
+size_t WorkerPool::Threads()
+{
+#ifndef ES_NO_THREADS
+	return GetPool().Threads();
+#else
+	return 1;
+#endif // ES_NO_THREADS
+}
@@ -0,0 +1,45 @@
+/* WorkerPool.h
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef WORKER_POOL_H_
+#define WORKER_POOL_H_
+
+#include <cstddef>
+#include <functional>
+
+
+
+// This class is a collection of global functions for spreading independent
+// pieces of work across a set of worker threads. The threads are created the
+// first time they are needed, and the thread that asks for the work to be done
+// also takes part in it, so Run() does not return until all the work is done.
+// If the pool is already busy (e.g. Run() is called from inside a task, or from
+// two threads at once), or if threads are not available, the work is simply
+// done on the calling thread.
+class WorkerPool {
+public:
+	// Call the given function once for every index from 0 to count - 1. The
+	// calls may happen in any order and on any thread, so the function must
+	// only modify data that belongs to the index that it is given.
+	static void Run(size_t count, const std::function<void(size_t)> &function);
+
+	// Get the number of threads, including the calling thread, that may
+	// take part in running the work.
+	static size_t Threads();
+};
+
+
+
+#endif
@@ -16,10 +16,12 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 */
 
 #include "Audio.h"
+#include "Benchmark.h"
 #include "Command.h"
 #include "Conversation.h"
 #include "ConversationPanel.h"
 #include "DataFile.h"
+#include "DataFileCache.h"
 #include "DataNode.h"
 #include "DataWriter.h"
 #include "Dialog.h"
@@ -30,6 +32,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "GameLoadingPanel.h"
 #include "GameWindow.h"
 #include "Hardpoint.h"
+#include "ImageCache.h"
 #include "Logger.h"
 #include "MenuPanel.h"
 #include "Panel.h"
@@ -38,6 +41,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Preferences.h"
 #include "PrintData.h"
 #include "Screen.h"
+#include "Sprite.h"
 #include "SpriteSet.h"
 #include "SpriteShader.h"
 #include "Test.h"
@@ -50,6 +54,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <thread>
 
 #include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <future>
 #include <stdexcept>
 #include <string>
@@ -74,7 +81,9 @@ using namespace std;
 
 void PrintHelp();
 void PrintVersion();
-void GameLoop(PlayerInfo &player, const Conversation &conversation, const string &testToRun, bool debugMode);
+bool ParseCount(const char *text, int &count);
+void GameLoop(PlayerInfo &player, const Conversation &conversation, const string &testToRun, bool debugMode,
+	bool showMenuEarly);
 Conversation LoadConversation();
 void PrintTestsTable();
 #ifdef _WIN32
@@ -116,7 +125,13 @@ int main(int argc, char *argv[])
 	bool printTests = false;
 	bool printData = false;
 	bool noTestMute = false;
+	bool useDataCache = false;
+	bool useImageCache = false;
+	bool showMenuEarly = false;
+	int spriteBudget = -1;
 	string testToRunName = "";
+	string benchmarkSave;
+	int benchmarkSteps = 3600;
 
 	// Ensure that we log errors to the errors.txt file.
 	Logger::SetLogErrorCallback([](const string &errorMessage) { Files::LogErrorToFile(errorMessage); });
@@ -146,26 +161,58 @@ int main(int argc, char *argv[])
 			printTests = true;
 		else if(arg == "--nomute")
 			noTestMute = true;
+		else if(arg == "--data-cache")
+			useDataCache = true;
+		else if(arg == "--image-cache")
+			useImageCache = true;
+		else if(arg == "--early-menu")
+			showMenuEarly = true;
+		else if(arg == "--benchmark" && *++it)
+			benchmarkSave = *it;
+		else if((arg == "--lazy-sprites" || arg == "--steps") && *++it)
+		{
+			if(!ParseCount(*it, arg == "--steps" ? benchmarkSteps : spriteBudget))
+			{
+				cerr << "Invalid value for " << arg << ": \"" << *it << "\"" << endl << endl;
+				PrintHelp();
+				return 1;
+			}
+		}
 	}
 	printData = PrintData::IsPrintDataArgument(argv);
 	Files::Init(argv);
+	// Keep parsed copies of the game data files, so they load faster next time,
+	// if asked to.
+	if(useDataCache)
+		DataFileCache::Init(Files::Config() + "cache/");
+	// Decoded images take up about four times as much space as the image files,
+	// so they are only cached if asked for.
+	if(useImageCache)
+	{
+		Files::CreateFolder(Files::Config() + "cache/");
+		ImageCache::Init(Files::Config() + "cache/images/");
+	}
 
 	try {
 		// Load plugin preferences before game data if any.
 		Plugins::LoadSettings();
 
-		// Begin loading the game data.
+		// Begin loading the game data. Benchmarks run without a window, so their
+		// sprites are loaded but never uploaded.
 		bool isConsoleOnly = loadOnly || printTests || printData;
+		bool isBenchmark = !benchmarkSave.empty();
+		if(spriteBudget >= 0)
+			GameData::LoadSpritesOnDemand(spriteBudget);
 #ifndef ES_NO_THREADS
-		future<void> dataLoading = GameData::BeginLoad(isConsoleOnly, debugMode);
+		future<void> dataLoading = GameData::BeginLoad(isConsoleOnly, debugMode, isBenchmark);
 #else
-		GameData::BeginLoad(isConsoleOnly, debugMode);
+		GameData::BeginLoad(isConsoleOnly, debugMode, isBenchmark);
 #endif // ES_NO_THREADS
 
 		// If we are not using the UI, or performing some automated task, we should load
 		// all data now. (Sprites and sounds can safely be deferred.)
 #ifndef ES_NO_THREADS
-		if(isConsoleOnly || !testToRunName.empty())
+		if(isConsoleOnly || isBenchmark || !testToRunName.empty())
 			dataLoading.wait();
 #endif // ES_NO_THREADS
 
@@ -185,6 +232,8 @@ int main(int argc, char *argv[])
 			PrintTestsTable();
 			return 0;
 		}
+		if(isBenchmark)
+			return Benchmark::Run(benchmarkSave, benchmarkSteps);
 
 		PlayerInfo player;
 		if(loadOnly)
@@ -231,7 +280,7 @@ int main(int argc, char *argv[])
 		}
 
 		// This is the main loop where all the action begins.
-		GameLoop(player, conversation, testToRunName, debugMode);
+		GameLoop(player, conversation, testToRunName, debugMode, showMenuEarly);
 	}
 	catch(Test::known_failure_tag)
 	{
@@ -260,7 +309,8 @@ int main(int argc, char *argv[])
 
 
 
-void GameLoop(PlayerInfo &player, const Conversation &conversation, const string &testToRunName, bool debugMode)
+void GameLoop(PlayerInfo &player, const Conversation &conversation, const string &testToRunName, bool debugMode,
+	bool showMenuEarly)
 {
 	// gamePanels is used for the main panel where you fly your spaceship.
 	// All other game content related dialogs are placed on top of the gamePanels.
@@ -274,9 +324,9 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 	UI menuPanels;
 
 	// Whether the game data is done loading. This is used to trigger any
-	// tests to run.
+	// tests to run, and to enable the main menu's buttons that start the game.
 	bool dataFinishedLoading = false;
-	menuPanels.Push(new GameLoadingPanel(player, conversation, gamePanels, dataFinishedLoading));
+	menuPanels.Push(new GameLoadingPanel(player, conversation, gamePanels, dataFinishedLoading, showMenuEarly));
 
 	bool showCursor = true;
 	int cursorTime = 0;
@@ -324,7 +374,7 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 			{
 				// User pressed the Menu key.
 				menuPanels.Push(shared_ptr<Panel>(
-					new MenuPanel(player, gamePanels)));
+					new MenuPanel(player, gamePanels, dataFinishedLoading)));
 			}
 			else if(event.type == SDL_QUIT)
 			{
@@ -442,6 +492,12 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 		(menuPanels.IsEmpty() ? gamePanels : menuPanels).DrawAll();
 		if(isFastForward)
 			SpriteShader::Draw(SpriteSet::Get("ui/fast forward"), Screen::TopLeft() + Point(10., 10.));
+		// Upload any sprites that were first drawn in this frame, if sprites are
+		// only loaded once they are drawn. This may be called more than once in
+		// a frame, so the frame count that decides which sprites have not been
+		// drawn recently is advanced separately, exactly once per frame.
+		GameData::ProcessSprites();
+		Sprite::NextFrame();
 
 		GameWindow::Step();
 
@@ -476,6 +532,14 @@ void PrintHelp()
 	cerr << "    --tests: print table of available tests, then exit." << endl;
 	cerr << "    --test <name>: run given test from resources directory." << endl;
 	cerr << "    --nomute: don't mute the game while running tests." << endl;
+	cerr << "    --data-cache: keep a parsed copy of each data file, so it loads faster next time." << endl;
+	cerr << "    --early-menu: show the main menu as soon as the sprites it needs are loaded, and load the rest"
+			" while it is shown." << endl;
+	cerr << "    --image-cache: keep a decoded copy of each image, so it loads faster next time"
+			" (this takes about 1 GB of disk space)." << endl;
+	cerr << "    --lazy-sprites <megabytes>: only load images once they are drawn, and unload the least recently"
+			" drawn ones once they use more than the given amount of texture memory (0 for no limit)." << endl;
+	Benchmark::Help();
 	PrintData::Help();
 	cerr << endl;
 	cerr << "Report bugs to: <https://github.com/endless-sky/endless-sky/issues>" << endl;
@@ -485,6 +549,22 @@ void PrintHelp()
 
 
 
+// Read a command line argument that must be a number that is not negative.
+// Return false if it is not one.
+bool ParseCount(const char *text, int &count)
+{
+	char *end = nullptr;
+	errno = 0;
+	long value = strtol(text, &end, 10);
+	if(end == text || *end || errno || value < 0 || value > INT_MAX)
+		return false;
+
+	count = value;
+	return true;
+}
+
+
+
 void PrintVersion()
 {
 	cerr << endl;
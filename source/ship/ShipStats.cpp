@@ -0,0 +1,89 @@
+/* ShipStats.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ShipStats.h"
+
+#include "../Outfit.h"
+#include "../Ship.h"
+
+#include <cmath>
+#include <string>
+
+using namespace std;
+
+namespace {
+	// Get the amount of the given stat that can be repaired each frame, and the
+	// cost of each point of repair. Each attribute can be scaled by a multiplier.
+	ShipStats::Repair GetRepair(const Outfit &attributes, const string &available, const string &multiplier,
+		const string &cost)
+	{
+		ShipStats::Repair repair;
+		repair.available = attributes.Get(available) * (1. + attributes.Get(multiplier));
+		repair.energy = (attributes.Get(cost + " energy")
+			* (1. + attributes.Get(cost + " energy multiplier"))) / repair.available;
+		repair.fuel = (attributes.Get(cost + " fuel")
+			* (1. + attributes.Get(cost + " fuel multiplier"))) / repair.available;
+		repair.heat = (attributes.Get(cost + " heat")
+			* (1. + attributes.Get(cost + " heat multiplier"))) / repair.available;
+		return repair;
+	}
+
+	// Get the given status effect resistance, and the cost of each point of it.
+	ShipStats::Resistance GetResistance(const Outfit &attributes, const string &name)
+	{
+		ShipStats::Resistance resistance;
+		resistance.resistance = attributes.Get(name);
+		resistance.energy = attributes.Get(name + " energy") / resistance.resistance;
+		resistance.fuel = attributes.Get(name + " fuel") / resistance.resistance;
+		resistance.heat = attributes.Get(name + " heat") / resistance.resistance;
+		return resistance;
+	}
+}
+
+
+
+// Recalculate everything from the ship's current attributes.
+void ShipStats::Calibrate(const Ship &ship)
+{
+	const Outfit &attributes = ship.Attributes();
+
+	drag = attributes.Get("drag") / (1. + attributes.Get("drag reduction"));
+	inertiaDivisor = 1. + attributes.Get("inertia reduction");
+	thrust = attributes.Get("thrust");
+	if(!thrust)
+		thrust = attributes.Get("afterburner thrust");
+	turn = attributes.Get("turn");
+
+	heatDissipation = .001 * attributes.Get("heat dissipation");
+	// This is an S-curve where the efficiency is 100% if you have no outfits
+	// that create "cooling inefficiency", and as that value increases the
+	// efficiency stays high for a while, then drops off, then approaches 0.
+	double x = attributes.Get("cooling inefficiency");
+	coolingEfficiency = 2. + 2. / (1. + exp(x / -2.)) - 4. / (1. + exp(x / -4.));
+	cooling = coolingEfficiency * attributes.Get("cooling");
+	activeCooling = coolingEfficiency * attributes.Get("active cooling");
+
+	hullRepair = GetRepair(attributes, "hull repair rate", "hull repair multiplier", "hull");
+	shieldRepair = GetRepair(attributes, "shield generation", "shield generation multiplier", "shield");
+
+	ionResistance = GetResistance(attributes, "ion resistance");
+	scramblingResistance = GetResistance(attributes, "scramble resistance");
+	disruptionResistance = GetResistance(attributes, "disruption resistance");
+	slowingResistance = GetResistance(attributes, "slowing resistance");
+	dischargeResistance = GetResistance(attributes, "discharge resistance");
+	corrosionResistance = GetResistance(attributes, "corrosion resistance");
+	leakResistance = GetResistance(attributes, "leak resistance");
+	burnResistance = GetResistance(attributes, "burn resistance");
+}
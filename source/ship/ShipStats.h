@@ -0,0 +1,132 @@
+/* ShipStats.h
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SHIP_STATS_H_
+#define SHIP_STATS_H_
+
+class Ship;
+
+
+
+// A class which caches values that the ship's movement and generation need
+// every frame, but which only depend on the ship's attributes, so they only
+// change when an outfit is added or removed. Values that also depend on the
+// ship's mass, which changes whenever its cargo does, are not cached.
+class ShipStats {
+public:
+	// How much of a stat can be repaired each frame, and the energy, fuel, and
+	// heat that each point of repair costs.
+	class Repair {
+	public:
+		double available = 0.;
+		double energy = 0.;
+		double fuel = 0.;
+		double heat = 0.;
+	};
+
+	// How much of a status effect the ship can resist each frame, and the
+	// energy, fuel, and heat that each point of resistance costs.
+	class Resistance {
+	public:
+		double resistance = 0.;
+		double energy = 0.;
+		double fuel = 0.;
+		double heat = 0.;
+	};
+
+
+public:
+	ShipStats() = default;
+
+	// Recalculate everything from the ship's current attributes.
+	void Calibrate(const Ship &ship);
+
+	// Drag, accounting for drag reduction.
+	double Drag() const;
+	// The ship's mass is divided by this to get its inertial mass.
+	double InertiaDivisor() const;
+	// Forward thrust, or afterburner thrust if the ship has no thrusters.
+	double Thrust() const;
+	double Turn() const;
+
+	// Heat dissipation, in heat units per heat unit per frame.
+	double HeatDissipation() const;
+	// The multiplier for cooling efficiency, and the cooling after applying it.
+	double CoolingEfficiency() const;
+	double Cooling() const;
+	double ActiveCooling() const;
+
+	const Repair &HullRepair() const;
+	const Repair &ShieldRepair() const;
+
+	const Resistance &IonResistance() const;
+	const Resistance &ScramblingResistance() const;
+	const Resistance &DisruptionResistance() const;
+	const Resistance &SlowingResistance() const;
+	const Resistance &DischargeResistance() const;
+	const Resistance &CorrosionResistance() const;
+	const Resistance &LeakResistance() const;
+	const Resistance &BurnResistance() const;
+
+
+private:
+	double drag = 0.;
+	double inertiaDivisor = 1.;
+	double thrust = 0.;
+	double turn = 0.;
+
+	double heatDissipation = 0.;
+	double coolingEfficiency = 1.;
+	double cooling = 0.;
+	double activeCooling = 0.;
+
+	Repair hullRepair;
+	Repair shieldRepair;
+
+	Resistance ionResistance;
+	Resistance scramblingResistance;
+	Resistance disruptionResistance;
+	Resistance slowingResistance;
+	Resistance dischargeResistance;
+	Resistance corrosionResistance;
+	Resistance leakResistance;
+	Resistance burnResistance;
+};
+
+
+
+// Inline the accessors because they get called so frequently.
+inline double ShipStats::Drag() const { return drag; }
+inline double ShipStats::InertiaDivisor() const { return inertiaDivisor; }
+inline double ShipStats::Thrust() const { return thrust; }
+inline double ShipStats::Turn() const { return turn; }
+inline double ShipStats::HeatDissipation() const { return heatDissipation; }
+inline double ShipStats::CoolingEfficiency() const { return coolingEfficiency; }
+inline double ShipStats::Cooling() const { return cooling; }
+inline double ShipStats::ActiveCooling() const { return activeCooling; }
+inline const ShipStats::Repair &ShipStats::HullRepair() const { return hullRepair; }
+inline const ShipStats::Repair &ShipStats::ShieldRepair() const { return shieldRepair; }
+inline const ShipStats::Resistance &ShipStats::IonResistance() const { return ionResistance; }
+inline const ShipStats::Resistance &ShipStats::ScramblingResistance() const { return scramblingResistance; }
+inline const ShipStats::Resistance &ShipStats::DisruptionResistance() const { return disruptionResistance; }
+inline const ShipStats::Resistance &ShipStats::SlowingResistance() const { return slowingResistance; }
+inline const ShipStats::Resistance &ShipStats::DischargeResistance() const { return dischargeResistance; }
+inline const ShipStats::Resistance &ShipStats::CorrosionResistance() const { return corrosionResistance; }
+inline const ShipStats::Resistance &ShipStats::LeakResistance() const { return leakResistance; }
+inline const ShipStats::Resistance &ShipStats::BurnResistance() const { return burnResistance; }
+
+
+
+#endif
@@ -85,10 +85,11 @@ namespace Utf8 {
 
 
 	// Determines the number of bytes used by the unicode code point in utf8.
-	int CodePointBytes(const char *str)
+	// No more than the given number of bytes are read.
+	int CodePointBytes(const char *str, size_t length)
 	{
 		// end - 00000000
-		if(!str || !*str)
+		if(!str || !length || !*str)
 			return 0;
 
 		// 1 byte - 0xxxxxxx
@@ -96,7 +97,7 @@ namespace Utf8 {
 			return 1;
 
 		// invalid - 10?????? or 11?????? invalid
-		if((*str & 0x40) == 0 || (*(str + 1) & 0xc0) != 0x80)
+		if((*str & 0x40) == 0 || length < 2 || (*(str + 1) & 0xc0) != 0x80)
 			return -1;
 
 		// 2 bytes - 110xxxxx 10xxxxxx
@@ -104,7 +105,7 @@ namespace Utf8 {
 			return 2;
 
 		// invalid - 111????? 10?????? invalid
-		if((*(str + 2) & 0xc0) != 0x80)
+		if(length < 3 || (*(str + 2) & 0xc0) != 0x80)
 			return -1;
 
 		// 3 bytes - 1110xxxx 10xxxxxx 10xxxxxx
@@ -112,7 +113,7 @@ namespace Utf8 {
 			return 3;
 
 		// invalid - 1111???? 10?????? 10?????? invalid
-		if((*(str + 3) & 0xc0) != 0x80)
+		if(length < 4 || (*(str + 3) & 0xc0) != 0x80)
 			return -1;
 
 		// 4 bytes - 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
@@ -129,14 +130,23 @@ namespace Utf8 {
 	// Invalid codepoints are converted to 0xFFFFFFFF.
 	char32_t DecodeCodePoint(const string &str, size_t &pos)
 	{
-		if(pos >= str.length())
+		return DecodeCodePoint(str.data(), str.length(), pos);
+	}
+
+
+
+	// Decodes a unicode code point in the given utf8 buffer, which need not
+	// end in a null character.
+	char32_t DecodeCodePoint(const char *str, size_t length, size_t &pos)
+	{
+		if(pos >= length)
 		{
 			pos = string::npos;
 			return 0;
 		}
 
 		// invalid (-1) or end (0)
-		int bytes = CodePointBytes(str.c_str() + pos);
+		int bytes = CodePointBytes(str + pos, length - pos);
 		if(bytes < 1)
 		{
 			++pos;
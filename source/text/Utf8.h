@@ -37,6 +37,9 @@ namespace Utf8 {
 	// pos skips to the next unicode code point after pos in utf8,
 	// or is set string::npos when there are no more code points.
 	char32_t DecodeCodePoint(const std::string &str, std::size_t &pos);
+	// The same, but for a buffer of the given length that need not end in a
+	// null character, such as a memory-mapped file.
+	char32_t DecodeCodePoint(const char *str, std::size_t length, std::size_t &pos);
 }
 
 #endif
@@ -64,6 +64,16 @@ TEST_CASE( "Angle::Rotate", "[angle][rotate]" ) {
 	CHECK( rotate2.Y() == Approx(1.) );
 }
 
+TEST_CASE( "Angle::Bucket", "[angle][bucket]" ) {
+	CHECK( Angle().Bucket(64) == 0 );
+	CHECK( Angle(5.).Bucket(64) == 0 );
+	CHECK( Angle(6.).Bucket(64) == 1 );
+	CHECK( Angle(90.).Bucket(4) == 1 );
+	CHECK( Angle(-1.).Bucket(4) == 3 );
+	CHECK( Angle(359.).Bucket(65536) == Angle(359.).Bucket(65536) );
+	CHECK( Angle(180.).Bucket(1) == 0 );
+}
+
 TEST_CASE( "Angle arithmetic", "[angle][arithmetic]") {
 	Angle angle = 60.;
 	REQUIRE( angle.Degrees() == Approx(60.).margin(0.05) );
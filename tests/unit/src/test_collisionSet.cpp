@@ -0,0 +1,261 @@
+/* test_collisionSet.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/CollisionSet.h"
+
+// Include helpers for creating the objects to collide with.
+#include "../../../source/Body.h"
+#include "../../../source/GameData.h"
+#include "../../../source/ImageBuffer.h"
+#include "../../../source/Mask.h"
+#include "../../../source/MaskManager.h"
+#include "../../../source/Point.h"
+#include "../../../source/Projectile.h"
+#include "../../../source/Sprite.h"
+
+// ... and any system includes needed for the test file.
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// Get a sprite whose collision mask is a solid square. Bodies drawn with it
+// are half as wide as the sprite, and the square is half as wide as that.
+const Sprite *SquareSprite(int size)
+{
+	static std::map<int, std::unique_ptr<Sprite>> sprites;
+	std::unique_ptr<Sprite> &sprite = sprites[size];
+	if(sprite)
+		return sprite.get();
+
+	ImageBuffer image;
+	image.Allocate(size, size);
+	for(int y = 0; y < size; ++y)
+	{
+		uint32_t *row = image.Begin(y);
+		for(int x = 0; x < size; ++x)
+		{
+			bool inside = (x >= size / 4 && x < 3 * size / 4 && y >= size / 4 && y < 3 * size / 4);
+			row[x] = inside ? 0xFF000000 : 0;
+		}
+	}
+	std::vector<Mask> masks(1);
+	masks.front().Create(image);
+
+	sprite.reset(new Sprite("square " + std::to_string(size)));
+	GameData::GetMaskManager().SetMasks(sprite.get(), std::move(masks));
+	sprite->AddFrames(image, false, false);
+	return sprite.get();
+}
+
+// A projectile that moves along the given line in one step.
+class LineProjectile : public Projectile {
+public:
+	LineProjectile(const Point &from, const Point &to)
+		: Projectile(from, nullptr)
+	{
+		velocity = to - from;
+	}
+};
+
+// Bodies of a few different sizes, scattered around the origin.
+std::vector<Body> MakeBodies()
+{
+	std::vector<Body> bodies;
+	const int sizes[] = {16, 64, 256, 1024};
+	for(int i = 0; i < 40; ++i)
+	{
+		Point position((i * 797) % 3000 - 1500, (i * 1301) % 3000 - 1500);
+		bodies.emplace_back(SquareSprite(sizes[i % 4]), position);
+	}
+	return bodies;
+}
+
+// Lines of many lengths and directions, including ones that cross many cells,
+// ones that stay within one cell, and ones that do not move at all.
+std::vector<LineProjectile> MakeLines()
+{
+	std::vector<LineProjectile> lines;
+	for(int i = 0; i < 300; ++i)
+	{
+		Point from((i * 613) % 3200 - 1600, (i * 419) % 3200 - 1600);
+		double length = (i % 5 == 0) ? 0. : (i % 5) * (i % 7) * 40.;
+		Point direction(((i * 37) % 200) - 100, ((i * 53) % 200) - 100);
+		lines.emplace_back(from, from + direction.Unit() * length);
+	}
+	return lines;
+}
+
+void Fill(CollisionSet &collisions, std::vector<Body> &bodies)
+{
+	collisions.Clear(0);
+	for(Body &body : bodies)
+		collisions.Add(body);
+	collisions.Finish();
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Checking a batch of lines for collisions", "[CollisionSet]" ) {
+	std::vector<Body> bodies = MakeBodies();
+	std::vector<LineProjectile> lines = MakeLines();
+	std::vector<const Projectile *> batch;
+	for(const LineProjectile &line : lines)
+		batch.push_back(&line);
+
+	for(unsigned levels : {1u, 4u})
+	{
+		GIVEN( "a collision set with " + std::to_string(levels) + " levels" ) {
+			CollisionSet collisions(64, 64, levels);
+			Fill(collisions, bodies);
+
+			// Find what each line hits when it is checked on its own.
+			std::vector<std::pair<Body *, double>> expected;
+			int hits = 0;
+			for(const LineProjectile &line : lines)
+			{
+				double closest = 1.;
+				Body *body = collisions.Line(line, &closest);
+				expected.emplace_back(body, closest);
+				hits += (body != nullptr);
+			}
+			REQUIRE( hits > 10 );
+			REQUIRE( hits < static_cast<int>(lines.size()) );
+
+			for(bool parallel : {false, true})
+			{
+				WHEN( (parallel ? "the batch is checked in parallel" : "the batch is checked in one thread") ) {
+					std::vector<CollisionSet::Collision> results;
+					collisions.Lines(batch, results, parallel);
+					THEN( "each line hits the same object at the same distance" ) {
+						REQUIRE( results.size() == lines.size() );
+						int mismatches = 0;
+						for(size_t i = 0; i < lines.size(); ++i)
+							mismatches += (results[i].body != expected[i].first || results[i].distance != expected[i].second);
+						CHECK( mismatches == 0 );
+					}
+				}
+			}
+			WHEN( "some entries in the batch are null" ) {
+				std::vector<const Projectile *> partial = batch;
+				for(size_t i = 0; i < partial.size(); i += 3)
+					partial[i] = nullptr;
+				std::vector<CollisionSet::Collision> results;
+				collisions.Lines(partial, results);
+				THEN( "those entries hit nothing, and the others are unchanged" ) {
+					REQUIRE( results.size() == lines.size() );
+					int mismatches = 0;
+					for(size_t i = 0; i < lines.size(); ++i)
+					{
+						if(i % 3)
+							mismatches += (results[i].body != expected[i].first || results[i].distance != expected[i].second);
+						else
+							mismatches += (results[i].body != nullptr || results[i].distance != 1.);
+					}
+					CHECK( mismatches == 0 );
+				}
+			}
+		}
+	}
+}
+
+SCENARIO( "Storing large and small objects in a multi-level grid", "[CollisionSet]" ) {
+	GIVEN( "the same objects in a single-level and a multi-level grid" ) {
+		std::vector<Body> bodies = MakeBodies();
+		CollisionSet single(64, 64);
+		CollisionSet multiple(64, 64, 4);
+		Fill(single, bodies);
+		Fill(multiple, bodies);
+
+		THEN( "every line hits the same object at the same distance in both" ) {
+			int hits = 0;
+			int mismatches = 0;
+			for(const LineProjectile &line : MakeLines())
+			{
+				double singleClosest = 1.;
+				double multipleClosest = 1.;
+				Body *singleBody = single.Line(line, &singleClosest);
+				Body *multipleBody = multiple.Line(line, &multipleClosest);
+				hits += (singleBody != nullptr);
+				mismatches += (singleBody != multipleBody || singleClosest != multipleClosest);
+			}
+			CHECK( hits > 10 );
+			CHECK( mismatches == 0 );
+		}
+		THEN( "every circle contains the same objects in both" ) {
+			int mismatches = 0;
+			for(int i = 0; i < 50; ++i)
+			{
+				Point center((i * 389) % 3200 - 1600, (i * 743) % 3200 - 1600);
+				double radius = 20. + (i % 6) * 100.;
+				const std::vector<Body *> &singleResult = single.Circle(center, radius);
+				std::multiset<Body *> singleBodies(singleResult.begin(), singleResult.end());
+				const std::vector<Body *> &multipleResult = multiple.Circle(center, radius);
+				std::multiset<Body *> multipleBodies(multipleResult.begin(), multipleResult.end());
+				mismatches += (singleBodies != multipleBodies);
+			}
+			CHECK( mismatches == 0 );
+		}
+	}
+	GIVEN( "objects that are far enough apart to share grid cells when the grid wraps around" ) {
+		// Both grids wrap around every 64 cells, so these are in the same cell
+		// of the finest level, and the large objects are in the same cell of
+		// the coarsest level.
+		const double wrap = 64. * 64.;
+		std::vector<Body> bodies;
+		bodies.emplace_back(SquareSprite(16), Point(100., 100.));
+		bodies.emplace_back(SquareSprite(16), Point(100. + wrap, 100.));
+		bodies.emplace_back(SquareSprite(1024), Point(-1000., -1000.));
+		bodies.emplace_back(SquareSprite(1024), Point(-1000., -1000. + 8. * wrap));
+		CollisionSet single(64, 64);
+		CollisionSet multiple(64, 64, 4);
+		Fill(single, bodies);
+		Fill(multiple, bodies);
+
+		for(CollisionSet *collisions : {&single, &multiple})
+		{
+			const char *name = (collisions == &single ? "single-level grid" : "multi-level grid");
+			THEN( std::string("a line only hits the nearby object in the ") + name ) {
+				CHECK( collisions->Line(LineProjectile(Point(80., 100.), Point(120., 100.))) == &bodies[0] );
+				CHECK( collisions->Line(LineProjectile(Point(80. + wrap, 100.), Point(120. + wrap, 100.))) == &bodies[1] );
+				CHECK( collisions->Line(LineProjectile(Point(-1300., -1000.), Point(-700., -1000.))) == &bodies[2] );
+				LineProjectile farLine(Point(-1300., -1000. + 8. * wrap), Point(-700., -1000. + 8. * wrap));
+				CHECK( collisions->Line(farLine) == &bodies[3] );
+			}
+			THEN( std::string("a circle only contains the nearby object in the ") + name ) {
+				const std::vector<Body *> &small = collisions->Circle(Point(100., 100.), 10.);
+				CHECK( small == std::vector<Body *>{&bodies[0]} );
+				const std::vector<Body *> &large = collisions->Circle(Point(-1000., -1000. + 8. * wrap), 10.);
+				CHECK( large == std::vector<Body *>{&bodies[3]} );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,134 @@
+/* test_dataFileCache.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/DataFileCache.h"
+
+// Include helpers for creating and reading the cached files.
+#include "../../../source/DataFile.h"
+#include "../../../source/DataNode.h"
+#include "../../../source/Files.h"
+
+// ... and any system includes needed for the test file.
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+const std::string cacheDirectory = "data-file-cache-test/";
+const std::string dataPath = "data-file-cache-test.txt";
+const std::string dataText = R"(ship Kestrel
+	attributes
+		"mass" 120.5
+		cost -3e2 "two words"
+	# a comment
+	name `some "quoted" words` 0x1F
+		0 1 true
+)";
+
+// Count how many nodes in the two trees differ in their tokens, their line
+// numbers, or the numbers that their tokens are read as.
+int Mismatches(const DataNode &a, const DataNode &b)
+{
+	int mismatches = (a.Tokens() != b.Tokens() || a.Trace() != b.Trace());
+	for(int i = 0; i < a.Size() && i < b.Size(); ++i)
+	{
+		mismatches += (a.IsNumber(i) != b.IsNumber(i));
+		if(a.IsNumber(i) && b.IsNumber(i))
+			mismatches += (a.Value(i) != b.Value(i));
+	}
+
+	auto ait = a.begin();
+	auto bit = b.begin();
+	for( ; ait != a.end() && bit != b.end(); ++ait, ++bit)
+		mismatches += Mismatches(*ait, *bit);
+	mismatches += (ait != a.end()) + (bit != b.end());
+	return mismatches;
+}
+
+// Get the path of the only file in the cache.
+std::string CachedFile()
+{
+	std::vector<std::string> files = Files::List(cacheDirectory);
+	return files.size() == 1 ? files.front() : "";
+}
+
+void Cleanup()
+{
+	for(const std::string &file : Files::List(cacheDirectory))
+		Files::Delete(file);
+	Files::Delete(dataPath);
+	DataFileCache::Init("");
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Caching a parsed data file", "[DataFileCache]" ) {
+	Cleanup();
+	Files::Write(dataPath, dataText);
+	DataFileCache::Init(cacheDirectory);
+	REQUIRE( DataFileCache::IsEnabled() );
+
+	GIVEN( "a data file that has been parsed with the cache turned on" ) {
+		DataFile parsed;
+		parsed.Load(dataPath, true);
+		const std::string cachePath = CachedFile();
+		REQUIRE_FALSE( cachePath.empty() );
+
+		WHEN( "it is read back from the cache" ) {
+			DataNode cached;
+			REQUIRE( DataFileCache::Read(dataPath, cached) );
+			THEN( "it has the same nodes, tokens, line numbers, and values" ) {
+				REQUIRE( cached.HasChildren() );
+				CHECK( Mismatches(*parsed.begin(), *cached.begin()) == 0 );
+				CHECK( cached.begin()->begin()->begin()->Value(1) == 120.5 );
+				CHECK_FALSE( (cached.begin()->end() - 1)->IsNumber(2) );
+			}
+		}
+		WHEN( "the cached copy has been cut short" ) {
+			const std::string data = Files::Read(cachePath);
+			bool anyRead = false;
+			for(size_t size = 0; size < data.size(); ++size)
+			{
+				Files::WriteBinary(cachePath, data.substr(0, size));
+				DataNode cached;
+				anyRead |= DataFileCache::Read(dataPath, cached);
+				anyRead |= cached.HasChildren();
+			}
+			THEN( "it is never read" ) {
+				CHECK_FALSE( anyRead );
+			}
+		}
+		WHEN( "the data file has changed since it was cached" ) {
+			Files::Write(dataPath, dataText + "ship Sparrow\n");
+			DataNode cached;
+			THEN( "the cached copy is not read" ) {
+				CHECK_FALSE( DataFileCache::Read(dataPath, cached) );
+				CHECK_FALSE( cached.HasChildren() );
+			}
+		}
+	}
+	Cleanup();
+}
+// #endregion unit tests
+
+
+
+} // test namespace
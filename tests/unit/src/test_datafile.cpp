@@ -101,6 +101,31 @@ node2 hi
 					}
 		}
 	}
+	GIVEN( "A DataFile created with a stream that does not end in a newline" ) {
+		std::istringstream stream("node1\n\tchild \"last token\"");
+		const DataFile root(stream);
+
+		THEN( "the last line is still read in full" ) {
+			REQUIRE( std::distance(root.begin(), root.end()) == 1 );
+			REQUIRE( std::distance(root.begin()->begin(), root.begin()->end()) == 1 );
+			const DataNode &child = *root.begin()->begin();
+			REQUIRE( child.Size() == 2 );
+			CHECK( child.Token(0) == "child" );
+			CHECK( child.Token(1) == "last token" );
+		}
+	}
+	GIVEN( "A DataFile with nodes that have many siblings" ) {
+		std::istringstream stream("parent\n\tfirst\n\t\tgrand child\n\tsecond\n\tthird\n\tfourth\n\tfifth\n");
+		const DataFile root(stream);
+
+		THEN( "each node can still be traced back to its parents" ) {
+			const DataNode &first = *root.begin()->begin();
+			const DataNode &grand = *first.begin();
+			const std::vector<std::string> trace = {"L1:   parent", "L2:     first", "L3:       grand child"};
+			CHECK( grand.Trace() == trace );
+			CHECK( (root.begin()->end() - 1)->Trace().back() == "L7:     fifth" );
+		}
+	}
 }
 
 SCENARIO( "Loading a DataFile with missing quotes", "[DataFile]" ) {
@@ -246,6 +246,37 @@ SCENARIO( "Determining if a token is numeric", "[IsNumber][Parsing][DataNode]" )
 	}
 }
 
+SCENARIO( "Reading the numeric value of a token", "[Value][Parsing][DataNode]" ) {
+	GIVEN( "A DataNode with numeric and non-numeric tokens" ) {
+		DataNode root = AsDataNode("root 12 monkey -3.5e2");
+		THEN( "IsNumber and Value agree with the static helpers" ) {
+			CHECK_FALSE( root.IsNumber(0) );
+			CHECK( root.IsNumber(1) );
+			CHECK_FALSE( root.IsNumber(2) );
+			CHECK( root.IsNumber(3) );
+			CHECK( root.Value(1) == 12. );
+			CHECK( root.Value(3) == DataNode::Value("-3.5e2") );
+		}
+		THEN( "repeated lookups return the same value" ) {
+			CHECK( root.Value(1) == 12. );
+			CHECK( root.Value(1) == 12. );
+			CHECK( root.IsNumber(1) );
+		}
+		THEN( "out of bounds tokens are not numbers" ) {
+			CHECK_FALSE( root.IsNumber(4) );
+		}
+		WHEN( "the node is copied after its values are read" ) {
+			CHECK( root.Value(3) == -350. );
+			DataNode copy(root);
+			THEN( "the copy has the same values" ) {
+				CHECK( copy.IsNumber(1) );
+				CHECK_FALSE( copy.IsNumber(2) );
+				CHECK( copy.Value(3) == -350. );
+			}
+		}
+	}
+}
+
 SCENARIO( "Determining if a token is a boolean", "[Boolean][Parsing][DataNode]" ) {
 	GIVEN( "A string that is \"true\"/\"1\" or \"false\"/\"0\"" ) {
 		THEN( "IsBool returns true" ) {
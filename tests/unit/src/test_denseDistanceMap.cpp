@@ -0,0 +1,214 @@
+/* test_denseDistanceMap.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/DenseDistanceMap.h"
+
+// Include a helper for creating the systems to search.
+#include "../../../source/DistanceMap.h"
+#include "../../../source/Set.h"
+#include "../../../source/System.h"
+
+// ... and any system includes needed for the test file.
+#include <algorithm>
+#include <set>
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+
+// Create the given number of systems, named "0", "1", ..., and link them
+// into a single line. A few extra links make some routes shorter.
+void MakeGalaxy(Set<System> &systems, int count)
+{
+	for(int i = 0; i < count; ++i)
+		systems.Get(std::to_string(i))->SetName(std::to_string(i));
+	for(int i = 1; i < count; ++i)
+		systems.Get(std::to_string(i - 1))->Link(systems.Get(std::to_string(i)));
+	for(int i = 0; i + 5 < count; i += 3)
+		systems.Get(std::to_string(i))->Link(systems.Get(std::to_string(i + 5)));
+
+	for(auto &it : systems)
+		it.second.UpdateSystem(systems, std::set<double>());
+}
+
+// Create a square grid of systems, named "x,y", with each linked to the systems
+// beside it. Many routes through it use the same fuel and take the same time.
+void MakeGrid(Set<System> &systems, int size)
+{
+	auto name = [](int x, int y) { return std::to_string(x) + "," + std::to_string(y); };
+	for(int x = 0; x < size; ++x)
+		for(int y = 0; y < size; ++y)
+		{
+			systems.Get(name(x, y))->SetName(name(x, y));
+			if(x)
+				systems.Get(name(x - 1, y))->Link(systems.Get(name(x, y)));
+			if(y)
+				systems.Get(name(x, y - 1))->Link(systems.Get(name(x, y)));
+		}
+
+	for(auto &it : systems)
+		it.second.UpdateSystem(systems, std::set<double>());
+}
+
+// Give every system that does not have an index one, numbering them after the
+// systems that do, like GameData does when systems are loaded or added.
+void IndexGalaxy(Set<System> &systems)
+{
+	unsigned index = 0;
+	for(const auto &it : systems)
+		if(it.second.Index() != System::NO_INDEX)
+			index = std::max(index, it.second.Index() + 1);
+	for(auto &it : systems)
+		if(it.second.Index() == System::NO_INDEX)
+			it.second.SetIndex(index++);
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Finding routes in a galaxy of indexed systems", "[denseDistanceMap]" ) {
+	Set<System> systems;
+	MakeGalaxy(systems, 4);
+	IndexGalaxy(systems);
+	const System *first = systems.Get("0");
+	const System *last = systems.Get("3");
+
+	GIVEN( "no limits" ) {
+		DenseDistanceMap map(first);
+		THEN( "every linked system is reached" ) {
+			CHECK( map.Systems().size() == 4 );
+			CHECK( map.Days(first) == 0 );
+			CHECK( map.Days(last) == 3 );
+			CHECK( map.Route(last) == systems.Get("2") );
+			CHECK( map.Route(first) == nullptr );
+			CHECK( map.RequiredFuel(first, last) == 300 );
+			CHECK( map.End() == first );
+		}
+	}
+	GIVEN( "a maximum distance" ) {
+		DenseDistanceMap map(first, WormholeStrategy::NONE, false, -1, 2);
+		THEN( "systems that are farther away are not reached" ) {
+			CHECK( map.HasRoute(systems.Get("2")) );
+			CHECK_FALSE( map.HasRoute(last) );
+			CHECK( map.Days(last) == -1 );
+		}
+	}
+	GIVEN( "a maximum count" ) {
+		DenseDistanceMap map(first, WormholeStrategy::NONE, false, 1);
+		THEN( "only that many systems are added to the center" ) {
+			CHECK( map.Systems().size() == 2 );
+		}
+	}
+	GIVEN( "a system that has not been indexed" ) {
+		System *added = systems.Get("new");
+		added->SetName("new");
+		systems.Get("3")->Link(added);
+		systems.Get("3")->UpdateSystem(systems, std::set<double>());
+		DenseDistanceMap map(first);
+		THEN( "it is never reached" ) {
+			CHECK_FALSE( map.HasRoute(added) );
+			CHECK( map.HasRoute(last) );
+		}
+		THEN( "a map around it is empty" ) {
+			CHECK( DenseDistanceMap(added).Systems().empty() );
+		}
+	}
+}
+
+SCENARIO( "A dense map agrees with a DistanceMap", "[denseDistanceMap]" ) {
+	GIVEN( "a larger galaxy" ) {
+		Set<System> systems;
+		MakeGalaxy(systems, 40);
+		const System *center = systems.Get("7");
+		// Systems without an index are searched the same way as before.
+		DistanceMap expected(center);
+		IndexGalaxy(systems);
+		DenseDistanceMap map(center);
+		THEN( "every system is the same number of days away" ) {
+			REQUIRE( map.Systems() == expected.Systems() );
+			int wrong = 0;
+			for(const auto &it : systems)
+				wrong += (map.Days(&it.second) != expected.Days(&it.second));
+			CHECK( wrong == 0 );
+		}
+	}
+	GIVEN( "a galaxy with many routes that are equally good" ) {
+		Set<System> systems;
+		MakeGrid(systems, 7);
+		const System *center = systems.Get("3,2");
+		DistanceMap expected(center);
+		IndexGalaxy(systems);
+		DenseDistanceMap map(center);
+		THEN( "ties are broken the same way" ) {
+			REQUIRE( map.Systems() == expected.Systems() );
+			int wrong = 0;
+			for(const auto &it : systems)
+				wrong += (map.Route(&it.second) != expected.Route(&it.second));
+			CHECK( wrong == 0 );
+		}
+	}
+}
+
+SCENARIO( "Using a dense map after a system is added", "[denseDistanceMap]" ) {
+	GIVEN( "a map made before the system was added" ) {
+		Set<System> systems;
+		MakeGalaxy(systems, 12);
+		IndexGalaxy(systems);
+		const System *center = systems.Get("4");
+		DenseDistanceMap map(center);
+		DistanceMap expected(center);
+		const unsigned centerIndex = center->Index();
+
+		// The new system's name comes first, but it is numbered last, so the
+		// other systems keep their indices.
+		System *added = systems.Get("00");
+		added->SetName("00");
+		added->Link(systems.Get("11"));
+		for(auto &it : systems)
+			it.second.UpdateSystem(systems, std::set<double>());
+		IndexGalaxy(systems);
+		REQUIRE( center->Index() == centerIndex );
+		REQUIRE( added->Index() == 12 );
+
+		THEN( "it still gives the routes that it found to each system" ) {
+			int wrong = 0;
+			for(const auto &it : systems)
+				if(&it.second != added)
+				{
+					wrong += (map.Days(&it.second) != expected.Days(&it.second));
+					wrong += (map.Route(&it.second) != expected.Route(&it.second));
+				}
+			CHECK( wrong == 0 );
+			CHECK_FALSE( map.HasRoute(added) );
+			CHECK( map.RequiredFuel(center, systems.Get("11")) == expected.RequiredFuel(center, systems.Get("11")) );
+		}
+		THEN( "a new map reaches the added system" ) {
+			DenseDistanceMap updated(center);
+			CHECK( updated.Days(added) == map.Days(systems.Get("11")) + 1 );
+			CHECK( updated.Route(added) == systems.Get("11") );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
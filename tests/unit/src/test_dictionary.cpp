@@ -53,6 +53,44 @@ SCENARIO( "A Dictionary instance is being used", "[dictionary]") {
 	}
 }
 
+SCENARIO( "Looking up values with a Dictionary::Key", "[dictionary]") {
+	GIVEN( "a dictionary and a key that was created before it" ) {
+		const Dictionary::Key key("test key before");
+		Dictionary dict;
+		THEN( "a missing key has a value of 0" ) {
+			CHECK( dict.Get(key) == 0. );
+		}
+		THEN( "the key finds its value, even when other values are added around it" ) {
+			dict["test key before"] = 5.;
+			CHECK( dict.Get(key) == 5. );
+			dict["a"] = 1.;
+			dict["z"] = 2.;
+			CHECK( dict.Get(key) == 5. );
+			dict["test key before"] = 7.;
+			CHECK( dict.Get(key) == 7. );
+		}
+		THEN( "copies of the dictionary find the same value" ) {
+			dict["test key before"] = 3.;
+			Dictionary copy = dict;
+			copy["b"] = 4.;
+			CHECK( copy.Get(key) == 3. );
+		}
+	}
+	GIVEN( "a key that was created after values were added" ) {
+		Dictionary dict;
+		dict["test key after"] = 9.;
+		const Dictionary::Key key("test key after");
+		THEN( "the key still finds its value" ) {
+			CHECK( dict.Get(key) == 9. );
+			dict["c"] = 1.;
+			CHECK( dict.Get(key) == 9. );
+		}
+		THEN( "it has the given name" ) {
+			CHECK( std::string(key.Name()) == "test key after" );
+		}
+	}
+}
+
 // #region benchmarks
 #ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
 TEST_CASE( "Benchmark Dictionary::Get", "[!benchmark][dictionary]" ) {
@@ -75,6 +113,13 @@ TEST_CASE( "Benchmark Dictionary::Get", "[!benchmark][dictionary]" ) {
 	BENCHMARK( "Dictionary::Get()", i ) {
 		return dict.Get(strings[i % SIZE]);
 	};
+
+	std::vector<Dictionary::Key> keys;
+	for(const std::string &str : strings)
+		keys.emplace_back(str.c_str());
+	BENCHMARK( "Dictionary::Get(Key)", i ) {
+		return dict.Get(keys[i % SIZE]);
+	};
 }
 #endif
 // #endregion benchmarks
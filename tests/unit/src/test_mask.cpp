@@ -0,0 +1,124 @@
+/* test_mask.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/Mask.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/Angle.h"
+#include "../../../source/ImageBuffer.h"
+#include "../../../source/Point.h"
+
+#include <cstdint>
+
+namespace { // test namespace
+
+// #region mock data
+// Fill the given image with a solid square, centered in the image, whose sides
+// are half as long as the image is wide.
+void FillSquare(ImageBuffer &image, int size)
+{
+	image.Allocate(size, size);
+	for(int y = 0; y < size; ++y)
+	{
+		uint32_t *row = image.Begin(y);
+		for(int x = 0; x < size; ++x)
+		{
+			bool inside = (x >= size / 4 && x < 3 * size / 4 && y >= size / 4 && y < 3 * size / 4);
+			row[x] = inside ? 0xFF000000 : 0;
+		}
+	}
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Colliding line segments with a mask", "[Mask]" ) {
+	GIVEN( "a mask that has not been created" ) {
+		Mask mask;
+		THEN( "nothing collides with it" ) {
+			CHECK_FALSE( mask.IsLoaded() );
+			CHECK( mask.Collide(Point(-20., 0.), Point(40., 0.), Angle()) == 1. );
+		}
+	}
+	GIVEN( "a mask made from a square" ) {
+		// Masks are made at half the size of the image, so this square is 16
+		// units wide and centered on the origin.
+		ImageBuffer image;
+		FillSquare(image, 64);
+		Mask mask;
+		mask.Create(image);
+		REQUIRE( mask.IsLoaded() );
+
+		THEN( "a segment that passes through it hits the near side" ) {
+			double range = mask.Collide(Point(-20., 0.), Point(40., 0.), Angle());
+			CHECK( range > .25 );
+			CHECK( range < .35 );
+		}
+		THEN( "the collision is about the same from every side" ) {
+			double left = mask.Collide(Point(-20., 0.), Point(40., 0.), Angle());
+			double right = mask.Collide(Point(20., 0.), Point(-40., 0.), Angle());
+			double top = mask.Collide(Point(0., -20.), Point(0., 40.), Angle());
+			double bottom = mask.Collide(Point(0., 20.), Point(0., -40.), Angle());
+			CHECK( right == Approx(left).margin(.02) );
+			CHECK( top == Approx(left).margin(.02) );
+			CHECK( bottom == Approx(left).margin(.02) );
+		}
+		THEN( "a segment that passes beside it misses" ) {
+			CHECK( mask.Collide(Point(-20., 15.), Point(40., 0.), Angle()) == 1. );
+		}
+		THEN( "a segment that ends before reaching it misses" ) {
+			CHECK( mask.Collide(Point(-20., 0.), Point(5., 0.), Angle()) == 1. );
+		}
+		THEN( "a segment that starts inside it hits immediately" ) {
+			CHECK( mask.Collide(Point(1., 2.), Point(40., 0.), Angle()) == 0. );
+		}
+		THEN( "rotating the mask brings a corner closer" ) {
+			double range = mask.Collide(Point(-20., 0.), Point(40., 0.), Angle(45.));
+			CHECK( range > .15 );
+			CHECK( range < mask.Collide(Point(-20., 0.), Point(40., 0.), Angle()) );
+		}
+		THEN( "caching bounding boxes does not change any results" ) {
+			Mask cached = mask;
+			cached.CacheBounds(64);
+			int different = 0;
+			for(int i = 0; i < 360; i += 7)
+				for(int j = -30; j <= 30; j += 3)
+				{
+					Angle facing(static_cast<double>(i));
+					Point start(-30., j);
+					Point ray(60., .5 * j);
+					different += (cached.Collide(start, ray, facing) != mask.Collide(start, ray, facing));
+					different += (cached.Contains(start * .3, facing) != mask.Contains(start * .3, facing));
+					different += (cached.WithinRing(start, facing, 20., 30.) != mask.WithinRing(start, facing, 20., 30.));
+				}
+			CHECK( different == 0 );
+		}
+		THEN( "a scaled copy of the mask is hit sooner" ) {
+			Mask scaled = mask * 2.;
+			double range = scaled.Collide(Point(-40., 0.), Point(80., 0.), Angle());
+			CHECK( range < mask.Collide(Point(-40., 0.), Point(80., 0.), Angle()) );
+			CHECK( range == Approx(mask.Collide(Point(-20., 0.), Point(40., 0.), Angle())) );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
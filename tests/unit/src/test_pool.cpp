@@ -0,0 +1,98 @@
+/* test_pool.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/Pool.h"
+
+// ... and any system includes needed for the test file.
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+class Pooled {
+public:
+	Pooled(const std::string &name, int value) : name(name), value(value) { ++alive; }
+	~Pooled() { --alive; }
+
+	std::string name;
+	int value;
+
+	static int alive;
+};
+
+int Pooled::alive = 0;
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Creating objects with a Pool", "[pool]" ) {
+	GIVEN( "an object made by the pool" ) {
+		std::shared_ptr<Pooled> object = Pool<Pooled>::Make("first", 1);
+		THEN( "it is constructed with the given arguments" ) {
+			REQUIRE( object );
+			CHECK( object->name == "first" );
+			CHECK( object->value == 1 );
+			CHECK( Pooled::alive == 1 );
+		}
+		WHEN( "the last shared pointer to it is released" ) {
+			std::weak_ptr<Pooled> weak = object;
+			object.reset();
+			THEN( "it is destroyed, and weak pointers to it expire" ) {
+				CHECK( Pooled::alive == 0 );
+				CHECK( weak.expired() );
+			}
+		}
+	}
+	GIVEN( "many objects" ) {
+		std::vector<std::shared_ptr<Pooled>> objects;
+		std::set<Pooled *> addresses;
+		for(int i = 0; i < 100; ++i)
+		{
+			objects.push_back(Pool<Pooled>::Make("object", i));
+			addresses.insert(objects.back().get());
+		}
+		THEN( "each one has its own memory" ) {
+			CHECK( addresses.size() == 100 );
+			bool valuesMatch = true;
+			for(int i = 0; i < 100; ++i)
+				valuesMatch &= (objects[i]->value == i);
+			CHECK( valuesMatch );
+		}
+		WHEN( "they are released and new objects are made" ) {
+			objects.clear();
+			for(int i = 0; i < 100; ++i)
+				objects.push_back(Pool<Pooled>::Make("again", i));
+			THEN( "the new objects reuse the same memory" ) {
+				int reused = 0;
+				for(const std::shared_ptr<Pooled> &object : objects)
+					reused += addresses.count(object.get());
+				CHECK( reused == 100 );
+				CHECK( Pooled::alive == 100 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -19,6 +19,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "../../../source/Random.h"
 
 // ... and any system includes needed for the test file.
+#include <cstdint>
 
 namespace { // test namespace
 
@@ -31,6 +32,70 @@ namespace { // test namespace
 TEST_CASE( "Random::Int", "[random][int]") {
 	REQUIRE( Random::Int(1) == 0 );
 }
+
+SCENARIO( "Drawing numbers from a random stream", "[random][stream]" ) {
+	GIVEN( "two streams with the same seed and key" ) {
+		Random::Stream first(1234, 5);
+		Random::Stream second(1234, 5);
+		THEN( "they produce the same numbers" ) {
+			bool same = true;
+			for(int i = 0; i < 100; ++i)
+				same &= (first.Int() == second.Int());
+			CHECK( same );
+		}
+	}
+	GIVEN( "two streams with different keys" ) {
+		Random::Stream first(1234, 5);
+		Random::Stream second(1234, 6);
+		THEN( "they produce different numbers" ) {
+			int same = 0;
+			for(int i = 0; i < 100; ++i)
+				same += (first.Int() == second.Int());
+			CHECK( same < 5 );
+		}
+	}
+	GIVEN( "a stream" ) {
+		Random::Stream stream(42);
+		THEN( "its numbers are within range" ) {
+			bool inRange = true;
+			for(int i = 0; i < 1000; ++i)
+			{
+				double real = stream.Real();
+				inRange &= (real >= 0. && real < 1. && stream.Int(60) < 60);
+			}
+			CHECK( inRange );
+		}
+	}
+}
+
+SCENARIO( "Using a stream in place of the generator", "[random][stream]" ) {
+	GIVEN( "a master seed" ) {
+		Random::Seed(99);
+		Random::Stream expected = Random::GetStream(3);
+		WHEN( "a stream is made active" ) {
+			Random::Stream stream = Random::GetStream(3);
+			Random::StreamScope scope(stream);
+			THEN( "the static functions draw from it" ) {
+				CHECK( Random::Int() == expected.Int() );
+				CHECK( Random::Int(1000) == expected.Int(1000) );
+				CHECK( Random::Real() == expected.Real() );
+			}
+		}
+		WHEN( "the stream's scope has ended" ) {
+			Random::Seed(99);
+			uint32_t value = Random::Int();
+			Random::Seed(99);
+			{
+				Random::Stream stream = Random::GetStream(3);
+				Random::StreamScope scope(stream);
+				Random::Int();
+			}
+			THEN( "the generator is used again, unaffected by the stream" ) {
+				CHECK( Random::Int() == value );
+			}
+		}
+	}
+}
 // Test code goes here. Preferably, use scenario-driven language making use of the SCENARIO, GIVEN,
 // WHEN, and THEN macros. (There will be cases where the more traditional TEST_CASE and SECTION macros
 // are better suited to declaration of the public API.)
@@ -0,0 +1,81 @@
+/* test_workerPool.cpp
+Copyright (c) 2026 by Thomas Ballinger
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/WorkerPool.h"
+
+// ... and any system includes needed for the test file.
+#include <cstddef>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// #endregion mock data
+
+
+
+// #region unit tests
+TEST_CASE( "WorkerPool::Threads", "[workerPool]" ) {
+	CHECK( WorkerPool::Threads() >= 1 );
+}
+
+SCENARIO( "Running work with the worker pool", "[workerPool]" ) {
+	GIVEN( "no work to do" ) {
+		int calls = 0;
+		WorkerPool::Run(0, [&calls](size_t) { ++calls; });
+		THEN( "the function is never called" ) {
+			CHECK( calls == 0 );
+		}
+	}
+	GIVEN( "many independent tasks" ) {
+		const size_t count = 10000;
+		std::vector<int> calls(count, 0);
+		std::vector<size_t> results(count, 0);
+		WorkerPool::Run(count, [&calls, &results](size_t i) {
+			++calls[i];
+			results[i] = i * i;
+		});
+		THEN( "every index is handled exactly once" ) {
+			size_t wrong = 0;
+			for(size_t i = 0; i < count; ++i)
+				wrong += (calls[i] != 1 || results[i] != i * i);
+			CHECK( wrong == 0 );
+		}
+	}
+	GIVEN( "tasks that use the pool themselves" ) {
+		const size_t count = 64;
+		std::vector<size_t> sums(count, 0);
+		WorkerPool::Run(count, [&sums](size_t i) {
+			std::vector<size_t> values(i, 0);
+			WorkerPool::Run(i, [&values](size_t j) { values[j] = j; });
+			for(size_t value : values)
+				sums[i] += value;
+		});
+		THEN( "the nested work is also done" ) {
+			size_t wrong = 0;
+			for(size_t i = 0; i < count; ++i)
+				wrong += (sums[i] != (i ? i * (i - 1) / 2 : 0));
+			CHECK( wrong == 0 );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace